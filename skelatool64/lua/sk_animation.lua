@@ -175,27 +175,73 @@ local function build_animation(armature, animation)
     return frames, n_frames
 end
 
+local function bone_frames_equal(a, b)
+    return a[1].x == b[1].x and a[1].y == b[1].y and a[1].z == b[1].z and
+        a[2][1] == b[2][1] and a[2][2] == b[2][2] and a[2][3] == b[2][3]
+end
+
+local function frames_equal(frames, n_bones, a, b)
+    for bone_index = 1,n_bones do
+        if not bone_frames_equal(frames[a * n_bones + bone_index], frames[b * n_bones + bone_index]) then
+            return false
+        end
+    end
+
+    return true
+end
+
+-- finds runs of frames where every bone holds the same pose
+local function build_animation_holds(frames, n_frames, n_bones)
+    local holds = {}
+    local hold_start = 0
+
+    for frame = 1,n_frames do
+        if frame == n_frames or not frames_equal(frames, n_bones, frame, hold_start) then
+            if frame - 1 > hold_start then
+                table.insert(holds, {hold_start, frame - 1})
+            end
+
+            hold_start = frame
+        end
+    end
+
+    return holds
+end
+
 --- @table Clip
 --- @tfield number nFrames
 --- @tfield number nBones
 --- @tfield sk_definition_writer.RefType frames
 --- @tfield number fps
+--- @tfield sk_definition_writer.RefType holds
+--- @tfield number nHolds
 
 --- @function build_animation_clip
 --- @tparam sk_scene.Animation animation
 --- @tparam Armature armature
 --- @tparam string animation_file_suffix
+--- @tparam string|nil clip_file_suffix where the hold ranges are written, defaults to _geo
 --- @treturn Clip the exported clip object use sk_definition_writer.reference_to(clip) to reference in other data
-local function build_animation_clip(animation, armature, animation_file_suffix)
+local function build_animation_clip(animation, armature, animation_file_suffix, clip_file_suffix)
     local animation_frames, n_frames = build_animation(armature, animation)
     
     sk_definition_writer.add_definition(animation.name .. '_frames', 'struct SKAnimationBoneFrame[]', animation_file_suffix, animation_frames)
 
+    local holds = build_animation_holds(animation_frames, n_frames, #armature.nodes)
+    local holds_reference = sk_definition_writer.null_value
+
+    if #holds > 0 then
+        sk_definition_writer.add_definition(animation.name .. '_holds', 'struct SKAnimationHoldRange[]', clip_file_suffix or '_geo', holds)
+        holds_reference = sk_definition_writer.reference_to(holds, 1)
+    end
+
     local clip = {
         nFrames = n_frames,
         nBones = #armature.nodes,
         frames = sk_definition_writer.reference_to(animation_frames, 1),
-        fps = sk_input.settings.ticks_per_second
+        fps = sk_input.settings.ticks_per_second,
+        holds = holds_reference,
+        nHolds = #holds,
     }
 
     return clip
@@ -18,6 +18,15 @@ exports.add_macro = function(name, value)
     -- implmentation in LuaDefinitionWriter.cpp
 end
 
+---@function add_relocation_table
+---@tparam string nameHint a hint on how to name the table
+---@tparam string location the file suffix to collect pointers for
+---@treturn string the final name for the table. It is a null terminated list
+--- of every pointer in location that points to data in location
+exports.add_relocation_table = function(nameHint, location)
+    -- implmentation in LuaDefinitionWriter.cpp
+end
+
 local pending_definitions = {}
 
 --- @table RefType
@@ -49,8 +58,8 @@ exports.is_reference_type = is_reference_type
 --- @table RawType
 local RawType = {}
 
-local function raw(value)
-    return setmetatable({ value = value}, RawType)
+local function raw(value, is_pointer)
+    return setmetatable({ value = value, is_pointer = is_pointer}, RawType)
 end
 
 RawType.__index = RawType;
@@ -62,6 +71,7 @@ end
 --- renders a string directly in the ouptut instead of wrapping the output in quotes
 ---@function raw
 ---@tparam string value
+---@tparam[opt] boolean is_pointer set if value is the name of a definition that should be included in relocation tables
 ---@treturn RawType result
 exports.raw = raw
 
@@ -251,11 +261,19 @@ local function populate_name_mapping(path, object, result)
     end
 end
 
-local function replace_references(object, name_mapping, name_path)
+local function replace_references(object, name_mapping, name_path, relocations)
     if type(object) ~= "table" then
         return object
     end
 
+    if (is_raw(object)) then
+        if (object.is_pointer) then
+            table.insert(relocations, { field = name_path, target = object.value })
+        end
+
+        return object
+    end
+
     if (is_reference_type(object)) then
         if (object.value == nil) then
             return null_value
@@ -271,6 +289,8 @@ local function replace_references(object, name_mapping, name_path)
             reference_name = reference_name .. '[' .. (object.index - 1) .. ']'
         end
 
+        table.insert(relocations, { field = name_path, target = reference_name })
+
         return raw("&" .. reference_name)
     end
 
@@ -287,7 +307,7 @@ local function replace_references(object, name_mapping, name_path)
             name = name_path .. "." .. k
         end
 
-        local replacement = replace_references(v, name_mapping, name)
+        local replacement = replace_references(v, name_mapping, name, relocations)
 
         if (replacement ~= v) then
             changes[k] = replacement
@@ -343,7 +363,8 @@ local function process_definitions(definitions)
     end
 
     for k, v in pairs(definitions) do
-        v.data = replace_references(v.data, name_mapping, v.name)
+        v.relocations = {}
+        v.data = replace_references(v.data, name_mapping, v.name, v.relocations)
     end
 end
 
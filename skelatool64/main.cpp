@@ -23,6 +23,7 @@
 #include "src/materials/MaterialTranslator.h"
 #include "src/StringUtils.h"
 #include "src/lua_generator/LuaGenerator.h"
+#include "src/DisplayListGenerator.h"
 
 void handler(int sig) {
   void *array[10];
@@ -113,6 +114,10 @@ int main(int argc, char *argv[]) {
     settings.mTicksPerSecond = args.mFPS;
     settings.mSortDirection = args.mSortDirection;
 
+    if (args.mOptimizationTime >= 0.0f) {
+        settings.mMaxOptimizationTime = args.mOptimizationTime;
+    }
+
     bool hasError = false;
 
     for (auto materialFile = args.mMaterialFiles.begin(); materialFile != args.mMaterialFiles.end(); ++materialFile) {
@@ -174,6 +179,10 @@ int main(int argc, char *argv[]) {
             meshGenerator.TraverseScene(scene);
             meshGenerator.PopulateBones(scene, fileDef);
             meshGenerator.GenerateDefinitions(scene, fileDef);
+
+            if (args.mRelocations) {
+                fileDef.AddRelocationTable("relocations", "_geo", true);
+            }
             break;
         }
         case FileOutputType::Materials:
@@ -206,6 +215,12 @@ int main(int argc, char *argv[]) {
         }
     }
 
+    if (gVertexLoadsBefore.mVerticesLoaded) {
+        std::cout << "Vertex loads " << 
+            gVertexLoadsBefore.mVtxCommands << " G_VTX / " << gVertexLoadsBefore.mVerticesLoaded << " vertices / " << gVertexLoadsBefore.mTriangleCommands << " triangle commands -> " <<
+            gVertexLoadsAfter.mVtxCommands << " G_VTX / " << gVertexLoadsAfter.mVerticesLoaded << " vertices / " << gVertexLoadsAfter.mTriangleCommands << " triangle commands" << std::endl;
+    }
+
     std::cout << "Writing output" << std::endl;
     fileDef.GenerateAll(args.mOutputFile);
     
@@ -232,6 +232,24 @@ void CFileDefinition::AddHeader(const std::string& name) {
     mHeaders.insert(name);
 }
 
+void CFileDefinition::AddRelocation(const std::string& definitionName, const std::string& field, const std::string& target) {
+    for (auto& definition : mDefinitions) {
+        if (definition->GetName() == definitionName) {
+            definition->AddRelocation(field, target);
+            return;
+        }
+    }
+}
+
+std::string CFileDefinition::AddRelocationTable(const std::string& nameHint, const std::string& location, bool includeDisplayLists) {
+    RelocationTable table;
+    table.mName = GetUniqueName(nameHint);
+    table.mLocation = location;
+    table.mIncludeDisplayLists = includeDisplayLists;
+    mRelocationTables.push_back(table);
+    return table.mName;
+}
+
 std::string CFileDefinition::GetVertexBuffer(std::shared_ptr<ExtendedMesh> mesh, VertexType vertexType, int textureWidth, int textureHeight, const std::string& modelSuffix, const PixelRGBAu8& defaultVertexColor) {
     for (auto existing = mVertexBuffers.begin(); existing != mVertexBuffers.end(); ++existing) {
         if (existing->second.mTargetMesh == mesh && existing->second.mVertexType == vertexType) {
@@ -344,7 +362,60 @@ std::string CFileDefinition::GetMacroName(std::string requestedName) {
 }
 
 
+// pulls the definition name out of expressions like &name[3]
+static std::string relocationTargetName(const std::string& target) {
+    std::size_t start = target.length() && target[0] == '&' ? 1 : 0;
+    std::size_t end = target.find_first_of("[.", start);
+
+    if (end == std::string::npos) {
+        return target.substr(start);
+    }
+
+    return target.substr(start, end - start);
+}
+
+void CFileDefinition::GenerateRelocationTables() {
+    for (auto& table : mRelocationTables) {
+        std::set<std::string> targets;
+
+        for (auto& definition : mDefinitions) {
+            if (definition->GetLocation() == table.mLocation) {
+                targets.insert(definition->GetName());
+            }
+        }
+
+        std::unique_ptr<StructureDataChunk> entries(new StructureDataChunk());
+
+        for (auto& definition : mDefinitions) {
+            if (definition->GetLocation() != table.mLocation) {
+                continue;
+            }
+
+            for (auto& relocation : definition->GetRelocations()) {
+                if (relocation.mIsDisplayList && !table.mIncludeDisplayLists) {
+                    continue;
+                }
+
+                // pointers to other segments don't move with this one
+                if (targets.find(relocationTargetName(relocation.mTarget)) == targets.end()) {
+                    continue;
+                }
+
+                entries->AddPrimitive("(void**)&" + relocation.mField);
+            }
+        }
+
+        entries->AddPrimitive(0);
+
+        AddDefinition(std::unique_ptr<FileDefinition>(new DataFileDefinition("void**", table.mName, true, table.mLocation, std::move(entries))));
+    }
+
+    mRelocationTables.clear();
+}
+
 void CFileDefinition::GenerateAll(const std::string& headerFileLocation) {
+    GenerateRelocationTables();
+
     std::set<std::string> keys;
 
     for (auto fileDef = mDefinitions.begin(); fileDef != mDefinitions.end(); ++fileDef) {
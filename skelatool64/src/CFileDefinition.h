@@ -27,6 +27,12 @@ public:
 private:
 };
 
+struct RelocationTable {
+    std::string mName;
+    std::string mLocation;
+    bool mIncludeDisplayLists;
+};
+
 class CFileDefinition {
 public:
     CFileDefinition(std::string prefix, float fixedPointScale, float modelScale, aiQuaternion modelRotate);
@@ -37,6 +43,11 @@ public:
 
     void AddHeader(const std::string& name);
 
+    void AddRelocation(const std::string& definitionName, const std::string& field, const std::string& target);
+    // collects every pointer in location that points back into location
+    // into a null terminated table so the data can be loaded at any address
+    std::string AddRelocationTable(const std::string& nameHint, const std::string& location, bool includeDisplayLists);
+
     std::string GetVertexBuffer(std::shared_ptr<ExtendedMesh> mesh, VertexType vertexType, int textureWidth, int textureHeight, const std::string& modelSuffix, const PixelRGBAu8& defaultVertexColor);
     std::string GetCullingBuffer(const std::string& name, const aiVector3D& min, const aiVector3D& max, const std::string& modelSuffix);
 
@@ -59,6 +70,8 @@ public:
 
     BoneHierarchy& GetBoneHierarchy();
 private:
+    void GenerateRelocationTables();
+
     std::string mPrefix;
     float mFixedPointScale;
     float mModelScale;
@@ -68,6 +81,7 @@ private:
     std::map<std::string, VertexBufferDefinition> mVertexBuffers;
     std::vector<std::unique_ptr<FileDefinition>> mDefinitions;
     std::vector<std::string> mMacros;
+    std::vector<RelocationTable> mRelocationTables;
     std::map<const void*, std::string> mResourceNames;
     std::map<aiMesh*, std::shared_ptr<ExtendedMesh>> mMeshes;
     BoneHierarchy mBoneHierarchy;
@@ -28,7 +28,9 @@ bool parseCommandLineArguments(int argc, char *argv[], struct CommandLineArgumen
     output.mDefaultMaterial = "default";
     output.mForceMaterialName = "";
     output.mProcessAsModel = false;
+    output.mRelocations = false;
     output.mFPS = 30.0f;
+    output.mOptimizationTime = -1.0f;
 
     std::string lastParameter = "";
     bool hasError = false;
@@ -66,6 +68,8 @@ bool parseCommandLineArguments(int argc, char *argv[], struct CommandLineArgumen
                 output.mScriptFiles.push_back(curr);
             } else if (lastParameter == "fps") {
                 output.mFPS = (float)atof(curr);
+            } else if (lastParameter == "optimize-time") {
+                output.mOptimizationTime = (float)atof(curr);
             }
 
             lastParameter = "";
@@ -117,6 +121,10 @@ bool parseCommandLineArguments(int argc, char *argv[], struct CommandLineArgumen
             output.mProcessAsModel = true;
         } else if (strcmp(curr, "--fps") == 0) {
             lastParameter = "fps";
+        } else if (strcmp(curr, "--optimize-time") == 0) {
+            lastParameter = "optimize-time";
+        } else if (strcmp(curr, "--relocations") == 0) {
+            output.mRelocations = true;
         } else {
             if (curr[0] == '-') {
                 hasError = true;
@@ -27,11 +27,13 @@ struct CommandLineArguments {
     float mFixedPointScale;
     float mModelScale;
     float mFPS;
+    float mOptimizationTime;
     bool mExportAnimation;
     bool mExportGeometry;
     bool mBonesAsVertexGroups;
     bool mTargetCIBuffer;
     bool mProcessAsModel;
+    bool mRelocations;
     aiVector3D mEulerAngles;
     aiVector3D mSortDirection;
 };
@@ -212,6 +212,12 @@ DisplayList::DisplayList(std::string name):
 }
 
 void DisplayList::AddCommand(std::unique_ptr<DisplayListCommand> command) {
+    if (command->mType == DisplayListCommandType::G_VTX) {
+        mPointerCommands.push_back(std::make_pair(mDataChunk->GetChildren().size(), static_cast<VTXCommand*>(command.get())->mVertexBuffer));
+    } else if (command->mType == DisplayListCommandType::G_DL) {
+        mPointerCommands.push_back(std::make_pair(mDataChunk->GetChildren().size(), static_cast<CallDisplayListByNameCommand*>(command.get())->mDLName));
+    }
+
     auto generatedCommand = command->GenerateCommand();
     mDataChunk->Add(std::move(generatedCommand));
 }
@@ -227,6 +233,31 @@ const std::string& DisplayList::GetName() {
 std::unique_ptr<FileDefinition> DisplayList::Generate(const std::string& fileSuffix) {
     mDataChunk->Add(std::unique_ptr<DataChunk>(new MacroDataChunk("gsSPEndDisplayList")));
 
+    std::vector<std::pair<std::string, std::string>> relocations;
+
+    // comments and nops don't take up a Gfx so the
+    // chunk index has to be converted to a command index
+    auto& children = mDataChunk->GetChildren();
+    int gfxIndex = 0;
+    unsigned chunkIndex = 0;
+
+    for (auto& pointerCommand : mPointerCommands) {
+        for (; chunkIndex < (unsigned)pointerCommand.first; ++chunkIndex) {
+            DataChunk* chunk = children[chunkIndex].get();
+
+            if (dynamic_cast<CommentDataChunk*>(chunk) == nullptr && 
+                dynamic_cast<DataChunkNop*>(chunk) == nullptr && 
+                dynamic_cast<NewlineHintChunk*>(chunk) == nullptr) {
+                ++gfxIndex;
+            }
+        }
+
+        relocations.push_back(std::make_pair(
+            mName + "[" + std::to_string(gfxIndex) + "].words.w1",
+            pointerCommand.second
+        ));
+    }
+
     std::unique_ptr<FileDefinition> result(new DataFileDefinition(
         std::string("Gfx"), 
         mName, 
@@ -237,5 +268,9 @@ std::unique_ptr<FileDefinition> DisplayList::Generate(const std::string& fileSuf
 
     result->AddTypeHeader("<ultra64.h>");
 
+    for (auto& relocation : relocations) {
+        result->AddRelocation(relocation.first, relocation.second, true);
+    }
+
     return result;
 }
@@ -148,6 +148,8 @@ public:
 private:
     std::string mName;
     std::unique_ptr<StructureDataChunk> mDataChunk;
+    // data chunk index and target of commands that point into the model
+    std::vector<std::pair<int, std::string>> mPointerCommands;
 };
 
 #endif
\ No newline at end of file
@@ -5,6 +5,11 @@
 
 #include "./DisplayListGenerator.h"
 
+VertexLoadStats::VertexLoadStats(): mVtxCommands(0), mVerticesLoaded(0), mTriangleCommands(0) {}
+
+VertexLoadStats gVertexLoadsBefore;
+VertexLoadStats gVertexLoadsAfter;
+
 bool doesFaceFit(std::set<int>& indices, aiFace* face, unsigned int maxVertices) {
     unsigned int misses = 0;
 
@@ -112,11 +117,151 @@ void generateCulling(DisplayList& output, std::string vertexBuffer, bool renable
     }
 }
 
-void generateGeometry(RenderChunk& chunk, RCPState& state, std::string vertexBuffer, DisplayList& output, bool hasTri2) {
+// mirrors how generateGeometry splits faces into vertex loads
+// vertex runs are approximated as consecutive indices
+void measureVertexLoads(const std::vector<aiFace*>& faces, unsigned int maxVertices, bool hasTri2, VertexLoadStats& stats) {
+    std::set<int> currentVertices;
+    unsigned int currentFaceCount = 0;
+
+    for (unsigned int faceIndex = 0; faceIndex <= faces.size(); ++faceIndex) {
+        if (faceIndex == faces.size() || !doesFaceFit(currentVertices, faces[faceIndex], maxVertices)) {
+            int lastVertex = -2;
+
+            for (auto vertex : currentVertices) {
+                if (vertex != lastVertex + 1) {
+                    ++stats.mVtxCommands;
+                }
+                lastVertex = vertex;
+            }
+
+            stats.mVerticesLoaded += currentVertices.size();
+            stats.mTriangleCommands += hasTri2 ? (currentFaceCount + 1) / 2 : currentFaceCount;
+
+            currentVertices.clear();
+            currentFaceCount = 0;
+
+            if (faceIndex == faces.size()) {
+                break;
+            }
+        }
+
+        for (unsigned int vertexIndex = 0; vertexIndex < faces[faceIndex]->mNumIndices; ++vertexIndex) {
+            currentVertices.insert(faces[faceIndex]->mIndices[vertexIndex]);
+        }
+
+        ++currentFaceCount;
+    }
+}
+
+// greedily fills each vertex load with the faces that need the fewest new
+// vertices. Since every load is flushed before the next one there is no
+// fifo cache to model, the goal is to reuse as much of each load as possible
+std::vector<aiFace*> optimizeFaceOrder(const std::vector<aiFace*>& faces, unsigned int maxVertices) {
+    std::map<int, std::vector<int>> facesForVertex;
+
+    for (unsigned int faceIndex = 0; faceIndex < faces.size(); ++faceIndex) {
+        for (unsigned int i = 0; i < faces[faceIndex]->mNumIndices; ++i) {
+            facesForVertex[faces[faceIndex]->mIndices[i]].push_back(faceIndex);
+        }
+    }
+
+    std::vector<bool> isUsed(faces.size());
+    std::vector<aiFace*> result;
+    result.reserve(faces.size());
+    unsigned int nextUnused = 0;
+
+    while (result.size() < faces.size()) {
+        std::set<int> currentVertices;
+
+        while (isUsed[nextUnused]) {
+            ++nextUnused;
+        }
+
+        int nextFace = nextUnused;
+
+        while (nextFace != -1) {
+            aiFace* face = faces[nextFace];
+            isUsed[nextFace] = true;
+            result.push_back(face);
+
+            for (unsigned int i = 0; i < face->mNumIndices; ++i) {
+                currentVertices.insert(face->mIndices[i]);
+            }
+
+            nextFace = -1;
+            unsigned int bestMisses = 0;
+
+            // only faces sharing a vertex with the current load can
+            // have fewer misses than an unrelated face
+            for (auto vertex : currentVertices) {
+                for (auto candidate : facesForVertex[vertex]) {
+                    if (isUsed[candidate]) {
+                        continue;
+                    }
+
+                    unsigned int misses = 0;
+
+                    for (unsigned int i = 0; i < faces[candidate]->mNumIndices; ++i) {
+                        if (currentVertices.find(faces[candidate]->mIndices[i]) == currentVertices.end()) {
+                            ++misses;
+                        }
+                    }
+
+                    if (currentVertices.size() + misses > maxVertices) {
+                        continue;
+                    }
+
+                    if (nextFace == -1 || misses < bestMisses || (misses == bestMisses && candidate < nextFace)) {
+                        nextFace = candidate;
+                        bestMisses = misses;
+                    }
+                }
+            }
+
+            if (nextFace != -1) {
+                continue;
+            }
+
+            // fill any remaining space with the next face in source order
+            while (nextUnused < faces.size() && isUsed[nextUnused]) {
+                ++nextUnused;
+            }
+
+            if (nextUnused < faces.size() && doesFaceFit(currentVertices, faces[nextUnused], maxVertices)) {
+                nextFace = nextUnused;
+            }
+        }
+    }
+
+    return result;
+}
+
+void generateGeometry(RenderChunk& chunk, RCPState& state, std::string vertexBuffer, DisplayList& output, bool hasTri2, bool preserveFaceOrder) {
     std::set<int> currentVertices;
     std::vector<aiFace*> currentFaces;
 
-    const std::vector<aiFace*>& faces = chunk.GetFaces();
+    const std::vector<aiFace*>& sourceFaces = chunk.GetFaces();
+    // faces sorted by depth have to be drawn in that order
+    std::vector<aiFace*> faces = preserveFaceOrder ? sourceFaces : optimizeFaceOrder(sourceFaces, state.GetMaxVertices());
+
+    VertexLoadStats before;
+    VertexLoadStats after;
+    measureVertexLoads(sourceFaces, state.GetMaxVertices(), hasTri2, before);
+    measureVertexLoads(faces, state.GetMaxVertices(), hasTri2, after);
+
+    // keep the source order if it was already better
+    if (preserveFaceOrder || after.mVerticesLoaded > before.mVerticesLoaded || 
+        (after.mVerticesLoaded == before.mVerticesLoaded && after.mVtxCommands > before.mVtxCommands)) {
+        faces = sourceFaces;
+        after = before;
+    }
+
+    gVertexLoadsBefore.mVtxCommands += before.mVtxCommands;
+    gVertexLoadsBefore.mVerticesLoaded += before.mVerticesLoaded;
+    gVertexLoadsBefore.mTriangleCommands += before.mTriangleCommands;
+    gVertexLoadsAfter.mVtxCommands += after.mVtxCommands;
+    gVertexLoadsAfter.mVerticesLoaded += after.mVerticesLoaded;
+    gVertexLoadsAfter.mTriangleCommands += after.mTriangleCommands;
 
     for (unsigned int faceIndex = 0; faceIndex <= faces.size(); ++faceIndex) {
         if (faceIndex == faces.size() || !doesFaceFit(currentVertices, faces[faceIndex], state.GetMaxVertices())) {
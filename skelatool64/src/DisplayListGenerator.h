@@ -7,7 +7,19 @@
 #include "./CFileDefinition.h"
 #include "./RenderChunk.h"
 
+struct VertexLoadStats {
+    VertexLoadStats();
+
+    unsigned mVtxCommands;
+    unsigned mVerticesLoaded;
+    unsigned mTriangleCommands;
+};
+
+// totals across every chunk generated with and without reordering faces
+extern VertexLoadStats gVertexLoadsBefore;
+extern VertexLoadStats gVertexLoadsAfter;
+
 void generateCulling(DisplayList& output, std::string vertexBuffer, bool renableLighting);
-void generateGeometry(RenderChunk& mesh, RCPState& state, std::string vertexBuffer, DisplayList& output, bool hasTri2);
+void generateGeometry(RenderChunk& mesh, RCPState& state, std::string vertexBuffer, DisplayList& output, bool hasTri2, bool preserveFaceOrder);
 
 #endif
\ No newline at end of file
@@ -10,6 +10,7 @@ DisplayListSettings::DisplayListSettings():
     mModelScale(1.0f),
     mMaxMatrixDepth(10),
     mMaxOptimizationIterations(DEFAULT_MAX_OPTIMIZATION_ITERATIONS),
+    mMaxOptimizationTime(DEFAULT_MAX_OPTIMIZATION_TIME),
     mCanPopMultipleMatrices(true),
     mTicksPerSecond(30.0f),
     mExportAnimation(true),
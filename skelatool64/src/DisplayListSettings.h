@@ -9,6 +9,9 @@
 #include "./materials/MaterialState.h"
 
 #define DEFAULT_MAX_OPTIMIZATION_ITERATIONS 1000
+// seconds, negative means no time limit so the output
+// doesn't depend on how fast the build machine is
+#define DEFAULT_MAX_OPTIMIZATION_TIME       -1.0f
 
 struct DisplayListSettings {
     DisplayListSettings();
@@ -19,6 +22,7 @@ struct DisplayListSettings {
     float mModelScale;
     int mMaxMatrixDepth;
     int mMaxOptimizationIterations;
+    float mMaxOptimizationTime;
     bool mCanPopMultipleMatrices;
     float mTicksPerSecond;
     std::map<std::string, std::shared_ptr<Material>> mMaterials;
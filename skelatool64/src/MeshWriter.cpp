@@ -117,7 +117,7 @@ void generateMeshIntoDLWithMaterials(const aiScene* scene, CFileDefinition& file
                 modelSuffix,
                 chunk->mMaterial->mDefaultVertexColor
             );
-            generateGeometry(*chunk, rcpState, vertexBuffer, displayList, settings.mHasTri2);
+            generateGeometry(*chunk, rcpState, vertexBuffer, displayList, settings.mHasTri2, settings.mSortDirection.SquareLength() > 0.0);
         } else if (chunk->mAttachedDLIndex != -1) {
             rcpState.TraverseToBone(chunk->mBonePair.first, displayList);
             displayList.AddCommand(std::unique_ptr<DisplayListCommand>(new CallDisplayListByNameCommand(std::string("(Gfx*)BONE_ATTACHMENT_SEGMENT_ADDRESS + " + std::to_string(chunk->mAttachedDLIndex)))));
@@ -7,6 +7,9 @@
 #include <vector>
 #include <algorithm>
 #include <memory>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
 
 EstimatedTime::EstimatedTime(): materialSwitching(0.0), matrixSwitching(0.0) {
     
@@ -21,56 +24,76 @@ double EstimatedTime::GetTotal() const {
     return matrixSwitching + materialSwitching;
 }
 
-struct RenderChunkPath {
-    RenderChunkPath(int size);
-
+// branch and bound nodes live in a single arena and only store the
+// last step of the path along with a bitmask of visited chunks
+struct RenderChunkPathNode {
     double bestCase;
     double worstCase;
     double currentLength;
-    int startIndex;
-    int currentIndex;
+    int parent;
+    int chunkIndex;
     int edgeCount;
-    // map to index to from index
-    std::vector<int> path;
+    int visitedOffset;
+};
 
-    bool IsDone() const;
+struct RenderChunkPathArena {
+    RenderChunkPathArena(int numberOfEdges);
 
-    bool operator <(const RenderChunkPath& other) const;
+    std::vector<RenderChunkPathNode> nodes;
+    std::vector<uint64_t> visited;
+    int wordsPerNode;
+
+    int AddNode(const RenderChunkPathNode& node, int copyVisitedFrom);
+    bool IsVisited(const RenderChunkPathNode& node, int chunkIndex) const;
+    void MarkVisited(RenderChunkPathNode& node, int chunkIndex);
 };
 
-RenderChunkPath::RenderChunkPath(int size) :
-    bestCase(0.0),
-    worstCase(0.0),
-    currentLength(0.0),
-    startIndex(-1),
-    currentIndex(0),
-    edgeCount(0),
-    path(size) {
-    for (int i = 0; i < size; ++i) {
-        path[i] = -1;
-    }
-}
+RenderChunkPathArena::RenderChunkPathArena(int numberOfEdges) :
+    wordsPerNode((numberOfEdges + 63) / 64) {
 
-bool RenderChunkPath::IsDone() const {
-    return startIndex == currentIndex && edgeCount > 0;
 }
 
-bool RenderChunkPath::operator <(const RenderChunkPath& other) const {
-    if (bestCase == other.bestCase) {
-        return worstCase > other.worstCase;
+int RenderChunkPathArena::AddNode(const RenderChunkPathNode& node, int copyVisitedFrom) {
+    int result = (int)nodes.size();
+    nodes.push_back(node);
+    nodes.back().visitedOffset = (int)visited.size();
+
+    if (copyVisitedFrom == -1) {
+        visited.resize(visited.size() + wordsPerNode);
+    } else {
+        int from = nodes[copyVisitedFrom].visitedOffset;
+
+        for (int i = 0; i < wordsPerNode; ++i) {
+            visited.push_back(visited[from + i]);
+        }
     }
 
-    return bestCase > other.bestCase;
+    return result;
+}
+
+bool RenderChunkPathArena::IsVisited(const RenderChunkPathNode& node, int chunkIndex) const {
+    return (visited[node.visitedOffset + (chunkIndex >> 6)] & (1ull << (chunkIndex & 63))) != 0;
+}
+
+void RenderChunkPathArena::MarkVisited(RenderChunkPathNode& node, int chunkIndex) {
+    visited[node.visitedOffset + (chunkIndex >> 6)] |= (1ull << (chunkIndex & 63));
 }
 
 class RenderChunkPathCompare {
     public:
-       bool operator()(const std::shared_ptr<RenderChunkPath>& a, const std::shared_ptr<RenderChunkPath>& b){
-           if(a->bestCase == b->bestCase){
-               return a->worstCase > b->worstCase;
-           }
-           return a->bestCase > b->bestCase;
-      }
+        RenderChunkPathCompare(const RenderChunkPathArena* arena): mArena(arena) {}
+
+        bool operator()(int aIndex, int bIndex) {
+            const RenderChunkPathNode& a = mArena->nodes[aIndex];
+            const RenderChunkPathNode& b = mArena->nodes[bIndex];
+
+            if(a.bestCase == b.bestCase){
+                return a.worstCase > b.worstCase;
+            }
+            return a.bestCase > b.bestCase;
+        }
+    private:
+        const RenderChunkPathArena* mArena;
 };
 
 struct RenderChunkDistanceGraph {
@@ -81,23 +104,18 @@ struct RenderChunkDistanceGraph {
     std::vector<double> matrixDistance;
     std::vector<double> minDistanceTo;
     std::vector<double> maxDistanceTo;
-    double bestWorstCase;
     int numberOfEdges;
 
-    std::priority_queue<std::shared_ptr<RenderChunkPath>, std::vector<std::shared_ptr<RenderChunkPath>>, RenderChunkPathCompare> currentChunks;
-
     double GetDistance(int from, int to) const;
     double GetMaterialDistance(int from, int to) const;
     double GetMatrixDistance(int from, int to) const;
     void SetDistance(int from, int to, struct EstimatedTime estimatedTime);
 
-    std::shared_ptr<RenderChunkPath> currentBest;
+    double GetTourLength(const std::vector<int>& tour) const;
 };
 
 RenderChunkDistanceGraph::RenderChunkDistanceGraph(int numberOfEdges) :
-    bestWorstCase(0.0),
-    numberOfEdges(numberOfEdges),
-    currentBest(nullptr) {
+    numberOfEdges(numberOfEdges) {
     edgeDistance.resize(numberOfEdges * numberOfEdges);
     materialDistance.resize(numberOfEdges * numberOfEdges);
     matrixDistance.resize(numberOfEdges * numberOfEdges);
@@ -124,163 +142,242 @@ void RenderChunkDistanceGraph::SetDistance(int from, int to, struct EstimatedTim
     matrixDistance[from * numberOfEdges + to] = estimatedTime.matrixSwitching;
 }
 
-void orderRenderGreedy(struct RenderChunkDistanceGraph& graph, struct RenderChunkPath& path);
+double RenderChunkDistanceGraph::GetTourLength(const std::vector<int>& tour) const {
+    double result = 0.0;
 
-void orderRenderAddNext(struct RenderChunkDistanceGraph& graph, std::shared_ptr<RenderChunkPath>& next) {
-    if (next->bestCase > graph.bestWorstCase) {
-        return;
+    for (unsigned i = 0; i < tour.size(); ++i) {
+        result += GetDistance(tour[i], tour[(i + 1) % tour.size()]);
     }
 
-    if (next->worstCase < graph.bestWorstCase) {
-        graph.bestWorstCase = next->worstCase;
+    return result;
+}
+
+class OptimizationTimer {
+public:
+    OptimizationTimer(double maxSeconds): 
+        mStart(std::chrono::steady_clock::now()),
+        mMaxSeconds(maxSeconds) {}
+
+    bool IsExpired() const {
+        return mMaxSeconds >= 0.0 && std::chrono::duration<double>(std::chrono::steady_clock::now() - mStart).count() > mMaxSeconds;
     }
+private:
+    std::chrono::steady_clock::time_point mStart;
+    double mMaxSeconds;
+};
+
+// tour is a list of chunk indices, the first index always stays in place
+void orderRenderGreedy(const struct RenderChunkDistanceGraph& graph, std::vector<int>& tour) {
+    std::vector<bool> isVisited(graph.numberOfEdges);
 
-    if (!next->IsDone()) {
-        graph.currentChunks.push(next);
-    } else if (graph.currentBest == nullptr || graph.currentBest->currentLength > next->currentLength) {
-        graph.currentBest = next;
+    tour.clear();
+    tour.push_back(0);
+    isVisited[0] = true;
+
+    while ((int)tour.size() < graph.numberOfEdges) {
+        int currentIndex = tour.back();
+        int toIndex = -1;
+        double minPathLength = 0.0;
+
+        for (int i = 0; i < graph.numberOfEdges; ++i) {
+            if (isVisited[i]) {
+                continue;
+            }
+
+            double edgeDistnace = graph.GetDistance(currentIndex, i);
+
+            if (toIndex == -1 || edgeDistnace < minPathLength) {
+                minPathLength = edgeDistnace;
+                toIndex = i;
+            }
+        }
+
+        isVisited[toIndex] = true;
+        tour.push_back(toIndex);
     }
 }
 
-void orderRenderPopulateNext(struct RenderChunkDistanceGraph& graph, struct RenderChunkPath& current) {
-    for (int i = 0; i < graph.numberOfEdges; ++i) {
-        if (i == current.startIndex) {
-            // leave start index to be last
-            continue;
-        }
+// reverses tour[start..end], edges are directed so the
+// reversed segment has to be measured in both directions
+bool orderRenderTwoOpt(const struct RenderChunkDistanceGraph& graph, std::vector<int>& tour) {
+    int n = (int)tour.size();
+    std::vector<double> forward(n);
+    std::vector<double> backward(n);
 
-        if (i == current.currentIndex) {
-            // dont go back to self
-            continue;
-        }
+    for (int i = 1; i < n; ++i) {
+        forward[i] = forward[i - 1] + graph.GetDistance(tour[i - 1], tour[i]);
+        backward[i] = backward[i - 1] + graph.GetDistance(tour[i], tour[i - 1]);
+    }
+
+    for (int start = 1; start < n - 1; ++start) {
+        int before = tour[start - 1];
+
+        for (int end = start + 1; end < n; ++end) {
+            int after = tour[(end + 1) % n];
+
+            double current = graph.GetDistance(before, tour[start]) + 
+                (forward[end] - forward[start]) + 
+                graph.GetDistance(tour[end], after);
+            double reversed = graph.GetDistance(before, tour[end]) + 
+                (backward[end] - backward[start]) + 
+                graph.GetDistance(tour[start], after);
 
-        if (current.path[i] != -1) {
-            // dont visit a node that has already been visited
-            continue;
+            if (reversed + 1e-9 < current) {
+                std::reverse(tour.begin() + start, tour.begin() + end + 1);
+                return true;
+            }
         }
+    }
+
+    return false;
+}
 
-        double edgeDistnace = graph.GetDistance(current.currentIndex, i);
+// moves a run of up to 3 chunks somewhere else in the tour without reversing it
+bool orderRenderOrOpt(const struct RenderChunkDistanceGraph& graph, std::vector<int>& tour) {
+    int n = (int)tour.size();
 
-        std::shared_ptr<RenderChunkPath> next(new RenderChunkPath(current));
+    for (int length = 1; length <= 3; ++length) {
+        for (int start = 1; start + length <= n; ++start) {
+            int end = start + length - 1;
+            int before = tour[start - 1];
+            int after = tour[(end + 1) % n];
 
-        next->bestCase += edgeDistnace - graph.minDistanceTo[i];
-        next->worstCase += edgeDistnace - graph.maxDistanceTo[i];
+            double removeGain = graph.GetDistance(before, tour[start]) + 
+                graph.GetDistance(tour[end], after) - 
+                graph.GetDistance(before, after);
 
-        next->currentLength += edgeDistnace;
-        next->edgeCount += 1;
-        next->path[i] = current.currentIndex;
+            for (int insert = 0; insert < n; ++insert) {
+                if (insert >= start - 1 && insert <= end) {
+                    continue;
+                }
 
-        if (next->startIndex == -1) {
-            next->startIndex = next->currentIndex;
-        }
+                int a = tour[insert];
+                int b = tour[(insert + 1) % n];
 
-        next->currentIndex = i;
+                double insertCost = graph.GetDistance(a, tour[start]) + 
+                    graph.GetDistance(tour[end], b) - 
+                    graph.GetDistance(a, b);
 
-        if (next->edgeCount + 1 == graph.numberOfEdges) {
-            next->currentLength += graph.GetDistance(next->currentIndex, next->startIndex);
-            next->path[next->startIndex] = next->currentIndex;
-            next->currentIndex = next->startIndex;
+                if (insertCost + 1e-9 < removeGain) {
+                    std::vector<int> segment(tour.begin() + start, tour.begin() + end + 1);
+                    tour.erase(tour.begin() + start, tour.begin() + end + 1);
 
-            next->bestCase = next->currentLength;
-            next->worstCase = next->currentLength;
+                    int insertAt = insert < start ? insert + 1 : insert + 1 - length;
+                    tour.insert(tour.begin() + insertAt, segment.begin(), segment.end());
+                    return true;
+                }
+            }
         }
+    }
+
+    return false;
+}
 
-        orderRenderAddNext(graph, next);
+void orderRenderLocalSearch(const struct RenderChunkDistanceGraph& graph, std::vector<int>& tour, const OptimizationTimer& timer) {
+    while (!timer.IsExpired()) {
+        if (!orderRenderOrOpt(graph, tour) && !orderRenderTwoOpt(graph, tour)) {
+            break;
+        }
     }
 }
 
-void orderRenderBnB(struct RenderChunkDistanceGraph& graph, int maxIterations) {
-    struct RenderChunkPath first(graph.numberOfEdges);
-    first.currentLength = 0.0f;
-    first.bestCase = 0.0f;
-    first.worstCase = 0.0f;
-    first.currentIndex = 0;
-    first.startIndex = -1;
+void orderRenderBnB(const struct RenderChunkDistanceGraph& graph, std::vector<int>& bestTour, int maxIterations, const OptimizationTimer& timer) {
+    double bestLength = graph.GetTourLength(bestTour);
+    double startLength = bestLength;
+
+    RenderChunkPathArena arena(graph.numberOfEdges);
+    std::priority_queue<int, std::vector<int>, RenderChunkPathCompare> currentChunks{RenderChunkPathCompare(&arena)};
+
+    RenderChunkPathNode first;
+    first.currentLength = 0.0;
+    first.bestCase = 0.0;
+    first.worstCase = 0.0;
+    first.parent = -1;
+    first.chunkIndex = 0;
+    first.edgeCount = 0;
 
     for (int i = 0; i < graph.numberOfEdges; ++i) {
         first.bestCase += graph.minDistanceTo[i];
         first.worstCase += graph.maxDistanceTo[i];
     }
 
-    graph.currentBest = std::shared_ptr<RenderChunkPath>(new RenderChunkPath(graph.numberOfEdges));
-
-    // get a base case
-    orderRenderGreedy(graph, *graph.currentBest);
-    graph.bestWorstCase = graph.currentBest->worstCase;
-
-    double greedyLength = graph.currentBest->currentLength;
-
-    orderRenderPopulateNext(graph, first);
+    int firstIndex = arena.AddNode(first, -1);
+    arena.MarkVisited(arena.nodes[firstIndex], 0);
+    currentChunks.push(firstIndex);
 
+    int bestNode = -1;
     int iteration = 0;
 
-    while (iteration < maxIterations && graph.currentChunks.size()) {
-        std::shared_ptr<RenderChunkPath> current = graph.currentChunks.top();
-        graph.currentChunks.pop();
+    while (iteration < maxIterations && currentChunks.size() && !timer.IsExpired()) {
+        int currentIndex = currentChunks.top();
+        currentChunks.pop();
 
-        if (current->bestCase > graph.currentBest->worstCase) {
+        if (arena.nodes[currentIndex].bestCase >= bestLength) {
             break;
         }
 
-        orderRenderPopulateNext(graph, *current);
+        for (int i = 1; i < graph.numberOfEdges; ++i) {
+            // copy since adding nodes can reallocate the arena
+            RenderChunkPathNode current = arena.nodes[currentIndex];
 
-        iteration += 1;
+            if (arena.IsVisited(current, i)) {
+                continue;
+            }
 
-        if ((iteration % 10000) == 0) {
-            std::cout << iteration << "/" << maxIterations << " searching for better solution. current improvement:" << (graph.currentBest->currentLength / greedyLength) << std::endl;
-        }
-    }
+            double edgeDistnace = graph.GetDistance(current.chunkIndex, i);
 
-    if (graph.currentBest->currentLength == greedyLength) {
-        std::cout << "Branch and bound could not find a better solution" << std::endl;
-    } else {
-        std::cout << "Branch and bound found a solution better by " << (graph.currentBest->currentLength / greedyLength) << std::endl;
-    }
-}
+            RenderChunkPathNode next = current;
+            next.parent = currentIndex;
+            next.chunkIndex = i;
+            next.edgeCount += 1;
+            next.currentLength += edgeDistnace;
+            next.bestCase += edgeDistnace - graph.minDistanceTo[i];
+            next.worstCase += edgeDistnace - graph.maxDistanceTo[i];
 
-void orderRenderGreedy(struct RenderChunkDistanceGraph& graph, struct RenderChunkPath& path) {
-    path.bestCase = 0.0f;
-    path.worstCase = 0.0f;
-    path.currentLength = 0.0f;
-    path.startIndex = 0;
-    path.currentIndex = 0;
-
-    while (!path.IsDone()) {
-        int toIndex = path.startIndex;
-        double minPathLength = graph.GetDistance(path.currentIndex, path.startIndex);
-        
-        for (int i = 0; i < graph.numberOfEdges; ++i) {
-            if (i == path.startIndex) {
-                // leave start index to be last
-                continue;
-            }
+            bool isDone = next.edgeCount + 1 == graph.numberOfEdges;
 
-            if (i == path.currentIndex) {
-                // dont go back to self
-                continue;
+            if (isDone) {
+                next.currentLength += graph.GetDistance(i, 0);
+                next.bestCase = next.currentLength;
+                next.worstCase = next.currentLength;
             }
 
-            if (path.path[i] != -1) {
-                // dont visit a node that has already been visited
+            if (next.bestCase >= bestLength) {
                 continue;
             }
 
-            double edgeDistnace = graph.GetDistance(path.currentIndex, i);
+            int nextIndex = arena.AddNode(next, currentIndex);
+            arena.MarkVisited(arena.nodes[nextIndex], i);
 
-            if (toIndex == path.startIndex || edgeDistnace < minPathLength) {
-                minPathLength = edgeDistnace;
-                toIndex = i;
+            if (isDone) {
+                bestLength = next.currentLength;
+                bestNode = nextIndex;
+            } else {
+                currentChunks.push(nextIndex);
             }
         }
 
-        path.currentLength += minPathLength;
-        path.path[toIndex] = path.currentIndex;
-        path.currentIndex = toIndex;
-        path.edgeCount += 1;
+        iteration += 1;
+
+        if ((iteration % 10000) == 0) {
+            std::cout << iteration << "/" << maxIterations << " searching for better solution. current improvement:" << (bestLength / startLength) << std::endl;
+        }
     }
 
-    path.bestCase = path.currentLength;
-    path.worstCase = path.currentLength;
+    if (bestNode == -1) {
+        std::cout << "Branch and bound could not find a better solution" << std::endl;
+        return;
+    }
+
+    bestTour.clear();
+
+    for (int node = bestNode; node != -1; node = arena.nodes[node].parent) {
+        bestTour.push_back(arena.nodes[node].chunkIndex);
+    }
+
+    std::reverse(bestTour.begin(), bestTour.end());
+
+    std::cout << "Branch and bound found a solution better by " << (bestLength / startLength) << std::endl;
 }
 
 struct EstimatedTime orderRenderDistance(const RenderChunk& from, const RenderChunk& to) {
@@ -317,24 +414,18 @@ struct EstimatedTime orderRenderDistance(const RenderChunk& from, const RenderCh
     return result;
 }
 
-void orderRenderExtract(const RenderChunkPath& path, std::vector<RenderChunk>& input, int startIndex, std::vector<RenderChunk>& output) {
-    int currentIndex = startIndex;
+void orderRenderExtract(const std::vector<int>& tour, std::vector<RenderChunk>& input, int startIndex, std::vector<RenderChunk>& output) {
+    auto start = std::find(tour.begin(), tour.end(), startIndex);
 
-    for (unsigned i = 0; i < path.path.size(); ++i) {
-        int nextIndex = path.path[currentIndex];
-
-        if (nextIndex == -1) {
-            output = input;
-            std::cerr << "A full path was not found" << std::endl;
-            return;
-        }
-
-        currentIndex = nextIndex;
-
-        output.push_back(input[currentIndex]);
+    if (tour.size() != input.size() || start == tour.end()) {
+        output = input;
+        std::cerr << "A full path was not found" << std::endl;
+        return;
     }
 
-    std::reverse(output.begin(), output.end());
+    for (unsigned i = 0; i < tour.size(); ++i) {
+        output.push_back(input[tour[(start - tour.begin() + i) % tour.size()]]);
+    }
 }
 
 void orderRenderChunks(std::vector<RenderChunk>& chunks, const DisplayListSettings& settings) {
@@ -387,10 +478,24 @@ void orderRenderChunks(std::vector<RenderChunk>& chunks, const DisplayListSettin
         }
     }
 
-    orderRenderBnB(graph, settings.mMaxOptimizationIterations);
+    OptimizationTimer timer(settings.mMaxOptimizationTime);
+
+    std::vector<int> tour;
+    orderRenderGreedy(graph, tour);
+
+    double greedyLength = graph.GetTourLength(tour);
+
+    // a tighter starting bound lets branch and bound prune much more
+    orderRenderLocalSearch(graph, tour, timer);
+
+    if (greedyLength > 0.0) {
+        std::cout << "Local search improved render order by " << (graph.GetTourLength(tour) / greedyLength) << std::endl;
+    }
+
+    orderRenderBnB(graph, tour, settings.mMaxOptimizationIterations, timer);
 
     std::vector<RenderChunk> result;
-    orderRenderExtract(*graph.currentBest, chunks, startIndex, result);
+    orderRenderExtract(tour, chunks, startIndex, result);
 
     if (result[0].mMesh == nullptr) {
         result.erase(result.begin());
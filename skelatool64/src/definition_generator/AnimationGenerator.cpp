@@ -200,43 +200,91 @@ std::string generateanimationV2(const aiAnimation& animation, int index, BoneHie
         }
     }
 
-    std::unique_ptr<StructureDataChunk> frames(new StructureDataChunk());
+    // quantize first so holds are detected on the data that is actually exported
+    std::vector<std::vector<short>> quantizedFrames(nFrames);
 
     for (int frame = 0; frame < nFrames; ++frame) {
         for (auto& frameBone : allFrameData[frame]) {
+            std::vector<short>& frameData = quantizedFrames[frame];
+
+            frameData.push_back((short)(frameBone.position.x));
+            frameData.push_back((short)(frameBone.position.y));
+            frameData.push_back((short)(frameBone.position.z));
+
+            float rotationSign = frameBone.rotation.w < 0.0f ? -1.0f : 1.0f;
+
+            frameData.push_back((short)(rotationSign * frameBone.rotation.x * std::numeric_limits<short>::max()));
+            frameData.push_back((short)(rotationSign * frameBone.rotation.y * std::numeric_limits<short>::max()));
+            frameData.push_back((short)(rotationSign * frameBone.rotation.z * std::numeric_limits<short>::max()));
+        }
+    }
+
+    std::unique_ptr<StructureDataChunk> frames(new StructureDataChunk());
+
+    for (int frame = 0; frame < nFrames; ++frame) {
+        std::vector<short>& frameData = quantizedFrames[frame];
+
+        for (unsigned offset = 0; offset < frameData.size(); offset += 6) {
             std::unique_ptr<StructureDataChunk> posData(new StructureDataChunk());
             std::unique_ptr<StructureDataChunk> rotData(new StructureDataChunk());
 
-            posData->AddPrimitive((short)(frameBone.position.x));
-            posData->AddPrimitive((short)(frameBone.position.y));
-            posData->AddPrimitive((short)(frameBone.position.z));
+            posData->AddPrimitive(frameData[offset + 0]);
+            posData->AddPrimitive(frameData[offset + 1]);
+            posData->AddPrimitive(frameData[offset + 2]);
 
-            if (frameBone.rotation.w < 0.0f) {
-                rotData->AddPrimitive((short)(-frameBone.rotation.x * std::numeric_limits<short>::max()));
-                rotData->AddPrimitive((short)(-frameBone.rotation.y * std::numeric_limits<short>::max()));
-                rotData->AddPrimitive((short)(-frameBone.rotation.z * std::numeric_limits<short>::max()));
-            } else {
-                rotData->AddPrimitive((short)(frameBone.rotation.x * std::numeric_limits<short>::max()));
-                rotData->AddPrimitive((short)(frameBone.rotation.y * std::numeric_limits<short>::max()));
-                rotData->AddPrimitive((short)(frameBone.rotation.z * std::numeric_limits<short>::max()));
-            }
+            rotData->AddPrimitive(frameData[offset + 3]);
+            rotData->AddPrimitive(frameData[offset + 4]);
+            rotData->AddPrimitive(frameData[offset + 5]);
 
-            std::unique_ptr<StructureDataChunk> frameData(new StructureDataChunk());
-            frameData->Add(std::move(posData));
-            frameData->Add(std::move(rotData));
-            frames->Add(std::move(frameData));
+            std::unique_ptr<StructureDataChunk> boneData(new StructureDataChunk());
+            boneData->Add(std::move(posData));
+            boneData->Add(std::move(rotData));
+            frames->Add(std::move(boneData));
         }
     }
 
     std::string framesName = fileDef.AddDataDefinition(std::string(animation.mName.C_Str()) + "_data", "struct SKAnimationBoneFrame", true, "_anim", std::move(frames));
 
+    // runs of frames where every bone has the same pose
+    std::unique_ptr<StructureDataChunk> holds(new StructureDataChunk());
+    int holdCount = 0;
+    int holdStart = 0;
+
+    for (int frame = 1; frame <= nFrames; ++frame) {
+        if (frame < nFrames && quantizedFrames[frame] == quantizedFrames[holdStart]) {
+            continue;
+        }
+
+        if (frame - 1 > holdStart) {
+            std::unique_ptr<StructureDataChunk> hold(new StructureDataChunk());
+            hold->AddPrimitive(holdStart);
+            hold->AddPrimitive(frame - 1);
+            holds->Add(std::move(hold));
+            ++holdCount;
+        }
+
+        holdStart = frame;
+    }
+
+    std::string holdsName = "NULL";
+
+    if (holdCount) {
+        holdsName = fileDef.AddDataDefinition(std::string(animation.mName.C_Str()) + "_holds", "struct SKAnimationHoldRange", true, "_geo", std::move(holds));
+    }
+
     std::unique_ptr<StructureDataChunk> clip(new StructureDataChunk());
     clip->AddPrimitive(nFrames);
     clip->AddPrimitive(bones.GetBoneCount());
     clip->AddPrimitive(framesName);
     clip->AddPrimitive(settings.mTicksPerSecond);
+    clip->AddPrimitive(holdsName);
+    clip->AddPrimitive(holdCount);
     std::string result = fileDef.AddDataDefinition(std::string(animation.mName.C_Str()) + "_clip", "struct SKAnimationClip", false, "_geo", std::move(clip));
 
+    if (holdCount) {
+        fileDef.AddRelocation(result, result + ".holds", holdsName);
+    }
+
     std::string animationMacroName = fileDef.GetUniqueName(std::string(animation.mName.C_Str()) + "_clip_index");
     std::transform(animationMacroName.begin(), animationMacroName.end(), animationMacroName.begin(), ::toupper);
     fileDef.AddMacro(animationMacroName, std::to_string(index));
@@ -246,13 +294,19 @@ std::string generateanimationV2(const aiAnimation& animation, int index, BoneHie
 
 void generateAnimationDataV2(const aiScene* scene, BoneHierarchy& bones, CFileDefinition& fileDef, const DisplayListSettings& settings) {
     std::unique_ptr<StructureDataChunk> clipArray(new StructureDataChunk());
+    std::vector<std::string> clipNames;
 
     for (unsigned animationIndex = 0; animationIndex < scene->mNumAnimations; ++animationIndex) {
         std::string clipName = generateanimationV2(*scene->mAnimations[animationIndex], animationIndex, bones, fileDef, settings);
         clipArray->AddPrimitive("&" + clipName);
+        clipNames.push_back(clipName);
     }
 
-    fileDef.AddDataDefinition("clips", "struct SKAnimationClip*", true, "_geo", std::move(clipArray));
+    std::string clipsName = fileDef.AddDataDefinition("clips", "struct SKAnimationClip*", true, "_geo", std::move(clipArray));
+
+    for (unsigned i = 0; i < clipNames.size(); ++i) {
+        fileDef.AddRelocation(clipsName, clipsName + "[" + std::to_string(i) + "]", clipNames[i]);
+    }
 
     std::string clipCountMacroName = fileDef.GetUniqueName("CLIP_COUNT");
     std::transform(clipCountMacroName.begin(), clipCountMacroName.end(), clipCountMacroName.begin(), ::toupper);
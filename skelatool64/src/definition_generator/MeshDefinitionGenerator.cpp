@@ -181,7 +181,11 @@ MeshDefinitionResults MeshDefinitionGenerator::GenerateDefinitionsWithResults(co
         armatureDef->AddPrimitive(animationResults.boneCountMacro);
         armatureDef->AddPrimitive(animationResults.numberOfAttachmentMacros);
 
-        fileDefinition.AddDataDefinition("armature", "struct SKArmatureDefinition", false, "_geo", std::move(armatureDef));
+        std::string armatureName = fileDefinition.AddDataDefinition("armature", "struct SKArmatureDefinition", false, "_geo", std::move(armatureDef));
+
+        fileDefinition.AddRelocation(armatureName, armatureName + ".displayList", result.modelName);
+        fileDefinition.AddRelocation(armatureName, armatureName + ".pose", animationResults.initialPoseReference);
+        fileDefinition.AddRelocation(armatureName, armatureName + ".boneParentIndex", animationResults.boneParentReference);
     }
     
     return result;
@@ -115,6 +115,10 @@ void StructureDataChunk::AddNewlineHint() {
     mChildren.push_back(std::unique_ptr<DataChunk>(new NewlineHintChunk()));
 }
 
+const std::vector<std::unique_ptr<DataChunk>>& StructureDataChunk::GetChildren() const {
+    return mChildren;
+}
+
 #define MAX_CHARS_PER_LINE  80
 #define SPACES_PER_INDENT   4
 
@@ -98,6 +98,8 @@ public:
 
     void AddNewlineHint();
 
+    const std::vector<std::unique_ptr<DataChunk>>& GetChildren() const;
+
     virtual bool Output(std::ostream& output, int indentLevel, int linePrefix);
     
     static void OutputIndent(std::ostream& output, int indentLevel);
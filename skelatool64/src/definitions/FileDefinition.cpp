@@ -1,6 +1,13 @@
 #include "FileDefinition.h"
 #include "../StringUtils.h"
 
+Relocation::Relocation(const std::string& field, const std::string& target, bool isDisplayList) :
+    mField(field),
+    mTarget(target),
+    mIsDisplayList(isDisplayList) {
+
+}
+
 FileDefinition::FileDefinition(const std::string& type, const std::string& name, bool isArray, std::string location) :
     mType(type),
     mName(name),
@@ -51,6 +58,14 @@ const std::string& FileDefinition::GetName() const {
     return mName;
 }
 
+void FileDefinition::AddRelocation(const std::string& field, const std::string& target, bool isDisplayList) {
+    mRelocations.push_back(Relocation(field, target, isDisplayList));
+}
+
+const std::vector<Relocation>& FileDefinition::GetRelocations() const {
+    return mRelocations;
+}
+
 DataFileDefinition::DataFileDefinition(const std::string& type, const std::string& name, bool isArray, std::string location, std::unique_ptr<DataChunk> data):
     FileDefinition(type, name, isArray, location),
     mData(std::move(data)) {
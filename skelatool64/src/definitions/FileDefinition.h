@@ -4,8 +4,20 @@
 #include <string>
 #include <ostream>
 #include <set>
+#include <vector>
 #include "DataChunk.h"
 
+struct Relocation {
+    Relocation(const std::string& field, const std::string& target, bool isDisplayList);
+
+    // c expression for the pointer that needs adjusting
+    std::string mField;
+    // what the pointer points to
+    std::string mTarget;
+    // display list pointers in levels are segmented and should be left alone
+    bool mIsDisplayList;
+};
+
 class FileDefinition {
 public:
     FileDefinition(const std::string& type, const std::string& name, bool isArray, std::string location);
@@ -24,6 +36,9 @@ public:
 
     const void* ForResource() const;
     const std::string& GetName() const;
+
+    void AddRelocation(const std::string& field, const std::string& target, bool isDisplayList = false);
+    const std::vector<Relocation>& GetRelocations() const;
 protected:
     std::string mType;
     std::string mName;
@@ -32,6 +47,7 @@ protected:
     const void* mForResource;
 
     std::set<std::string> mTypeHeaders;
+    std::vector<Relocation> mRelocations;
 };
 
 class DataFileDefinition : public FileDefinition {
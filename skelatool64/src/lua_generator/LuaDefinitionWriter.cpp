@@ -209,6 +209,21 @@ void processCFileDefinition(lua_State* L, CFileDefinition& fileDef, const char*
     lua_pop(L, 1);
 
     std::unique_ptr<FileDefinition> definition(new DataFileDefinition(dataType, definitionName, isArray, location, std::move(dataChunk)));
+
+    lua_getfield(L, topStart, "relocations");
+    int relocations = lua_gettop(L);
+
+    if (lua_istable(L, relocations)) {
+        lua_pushnil(L);  /* first key */
+        while (lua_next(L, relocations) != 0) {
+            lua_getfield(L, -1, "field");
+            lua_getfield(L, -2, "target");
+            definition->AddRelocation(lua_tostring(L, -2), lua_tostring(L, -1));
+            lua_pop(L, 3);
+        }
+    }
+    lua_pop(L, 1);
+
     fileDef.AddDefinition(std::move(definition));
 }
 
@@ -292,6 +307,13 @@ int luaAddMacro(lua_State* L) {
     return 1;
 }
 
+int luaAddRelocationTable(lua_State* L) {
+    CFileDefinition* fileDef = (CFileDefinition*)lua_touserdata(L, lua_upvalueindex(1));
+    std::string name = fileDef->AddRelocationTable(luaL_checkstring(L, 1), luaL_checkstring(L, 2), false);
+    lua_pushstring(L, name.c_str());
+    return 1;
+}
+
 int luaDefinitonWriterAppend(lua_State* L) {
     int moduleIndex = luaGetPrevModuleLoader(L);
     CFileDefinition* fileDef = (CFileDefinition*)lua_touserdata(L, lua_upvalueindex(2));
@@ -304,6 +326,10 @@ int luaDefinitonWriterAppend(lua_State* L) {
     lua_pushcclosure(L, luaAddMacro, 1);
     lua_setfield(L, moduleIndex, "add_macro");
 
+    lua_pushlightuserdata(L, fileDef);
+    lua_pushcclosure(L, luaAddRelocationTable, 1);
+    lua_setfield(L, moduleIndex, "add_relocation_table");
+
     return 1;
 }
 
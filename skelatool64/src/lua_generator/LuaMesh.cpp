@@ -615,7 +615,9 @@ int luaGetMeshVertexBuffer(lua_State* L) {
 
     luaLoadModuleFunction(L, "sk_definition_writer", "raw");
     toLua(L, result);
-    lua_call(L, 1, 1);
+    // the vertex buffer name is a pointer to data in the same file
+    lua_pushboolean(L, 1);
+    lua_call(L, 2, 1);
 
     return 1;
 }
@@ -19,6 +19,12 @@
 
 #define DMA_BUFFER_LENGTH       0x800  /* Larger buffers result in fewer DMA' but more  */
                                        /* memory being used.  */
+#define DMA_BUFFER_ALIGN_SHIFT  8
+#define DMA_BUFFER_ALIGN        (1 << DMA_BUFFER_ALIGN_SHIFT)
+#define DMA_HASH_SIZE           64     /* must be a power of 2                          */
+#define DMA_PREFETCH_LENGTH     0x400  /* How much of the next read a prefetch covers.  */
+#define DMA_PREFETCH_RESERVE    6      /* Free buffers kept back for non sequential     */
+                                       /* reads.                                        */
 
 
 #define NUM_ACMD_LISTS          2      /* two lists used by this example                */
@@ -49,12 +55,21 @@ typedef struct {
 } amConfig;
 
 
+struct AudioDMAStats {
+    u32 hits;
+    u32 misses;
+    u32 prefetches;
+    u32 prefetchHits;
+    u32 starved;
+};
+
 void amCreateAudioMgr(ALSynConfig *c, OSPri priority, amConfig *amc, int fps);
 void initAudio(int fps);
 
 extern u64        audYieldBuf[];
 extern u8*        gAudioHeapBuffer;
 extern ALHeap     gAudioHeap;
+extern struct AudioDMAStats gAudioDMAStats;
 
 #endif
 
@@ -39,21 +39,32 @@ typedef struct {
     ALGlobals     g;
 } AMAudioMgr;
 
-typedef struct 
+typedef struct AMDMABuffer_s
 {
     ALLink        node;
     u32           startAddr;
     u32           lastFrame;
     char          *ptr;
+    struct AMDMABuffer_s *hashNext;
+    u8            prefetched;
 } AMDMABuffer;
 
 typedef struct 
 {
     u8            initialized;
+    u8            freeCount;
+    u8            nextVoice;
     AMDMABuffer   *firstUsed;
     AMDMABuffer   *firstFree;
+    AMDMABuffer   *hash[DMA_HASH_SIZE];
 } AMDMAState;
 
+/* each voice gets its own state so sequential reads can be detected */
+typedef struct
+{
+    s32           nextAddr;
+} AMDMAVoiceState;
+
 
 /**** audio manager globals ****/
 extern OSSched         scheduler;
@@ -64,6 +75,8 @@ static u64      audioStack[AUDIO_STACKSIZE/sizeof(u64)];
 
 AMDMAState      dmaState;
 AMDMABuffer     dmaBuffs[NUM_DMA_BUFFERS];
+AMDMAVoiceState dmaVoiceState[MAX_VOICES];
+struct AudioDMAStats gAudioDMAStats;
 u32             audFrameCt = 0;
 u32             nextDMA = 0;
 u32             curAcmdList = 0;
@@ -80,7 +93,7 @@ OSMesg          audDMAMessageBuf[NUM_DMA_MESSAGES];
 /**** private routines ****/
 static void __amMain(void *arg);
 static s32  __amDMA(s32 addr, s32 len, void *state);
-static ALDMAproc __amDmaNew(AMDMAState **state);
+static ALDMAproc __amDmaNew(AMDMAVoiceState **state);
 static u32  __amHandleFrameMsg(AudioInfo *, AudioInfo *);
 static void __amHandleDoneMsg(AudioInfo *);
 static void __clearAudioDMA(void);
@@ -278,97 +291,211 @@ static void __amHandleDoneMsg(AudioInfo *info)
     }
 }
 
-s32 __amDMA(s32 addr, s32 len, void *state)
-{
-    void            *foundBuffer;
-    s32             delta, addrEnd, buffEnd;
-    AMDMABuffer     *dmaPtr, *lastDmaPtr;
-    
-    lastDmaPtr = 0;
-    dmaPtr = dmaState.firstUsed;
-    addrEnd = addr+len;
+#define DMA_HASH_INDEX(addr)   (((u32)(addr) >> DMA_BUFFER_ALIGN_SHIFT) & (DMA_HASH_SIZE - 1))
 
-    /* first check to see if a currently existing buffer contains the
-       sample that you need.  */
-    
-    while(dmaPtr)
+static AMDMABuffer* __amDMAFind(s32 addr, s32 addrEnd)
+{
+    s32             start;
+    AMDMABuffer     *dmaPtr;
+
+    /* buffers start on DMA_BUFFER_ALIGN boundaries so only a few
+       slots can contain this range */
+    for (start = addr & ~(DMA_BUFFER_ALIGN - 1); 
+        start >= 0 && start + DMA_BUFFER_LENGTH >= addrEnd; 
+        start -= DMA_BUFFER_ALIGN)
     {
-        buffEnd = dmaPtr->startAddr + DMA_BUFFER_LENGTH;
-        if(dmaPtr->startAddr > addr) /* since buffers are ordered */
-            break;                   /* abort if past possible */
+        for (dmaPtr = dmaState.hash[DMA_HASH_INDEX(start)]; dmaPtr; dmaPtr = dmaPtr->hashNext)
+        {
+            if (dmaPtr->startAddr <= addr && addrEnd <= dmaPtr->startAddr + DMA_BUFFER_LENGTH)
+                return dmaPtr;
+        }
+    }
+
+    return 0;
+}
+
+static void __amDMAUnhash(AMDMABuffer *dmaPtr)
+{
+    AMDMABuffer **curr = &dmaState.hash[DMA_HASH_INDEX(dmaPtr->startAddr)];
 
-        else if(addrEnd <= buffEnd) /* yes, found a buffer with samples */
+    while (*curr)
+    {
+        if (*curr == dmaPtr)
         {
-            dmaPtr->lastFrame = audFrameCt; /* mark it used */
-            foundBuffer = dmaPtr->ptr + addr - dmaPtr->startAddr;
-            return (int) osVirtualToPhysical(foundBuffer);
+            *curr = dmaPtr->hashNext;
+            break;
         }
-        lastDmaPtr = dmaPtr;
-        dmaPtr = (AMDMABuffer*)dmaPtr->node.next;
+        curr = &(*curr)->hashNext;
     }
 
-    /* get here, and you didn't find a buffer, so dma a new one */
+    dmaPtr->hashNext = 0;
+}
 
-    /* get a buffer from the free list */
-    dmaPtr = dmaState.firstFree;
+/* takes a buffer from the free list, or steals a prefetch that was never used */
+static AMDMABuffer* __amDMAAlloc(void)
+{
+    AMDMABuffer     *dmaPtr = dmaState.firstFree;
 
-    /* 
-     * if you get here and dmaPtr is null, send back the a bogus
-     * pointer, it's better than nothing
-     */
-    if(!dmaPtr)
-	return osVirtualToPhysical(dmaState.firstUsed);
+    if (dmaPtr)
+    {
+        dmaState.firstFree = (AMDMABuffer*)dmaPtr->node.next;
+        alUnlink((ALLink*)dmaPtr);
+        --dmaState.freeCount;
+    }
+    else
+    {
+        for (dmaPtr = dmaState.firstUsed; dmaPtr; dmaPtr = (AMDMABuffer*)dmaPtr->node.next)
+        {
+            if (dmaPtr->prefetched)
+                break;
+        }
 
-    dmaState.firstFree = (AMDMABuffer*)dmaPtr->node.next;
-    alUnlink((ALLink*)dmaPtr);
+        if (!dmaPtr)
+            return 0;
 
-    /* add it to the used list */
-    if(lastDmaPtr) /* if you have other dmabuffers used, add this one */
-    {              /* to the list, after the last one checked above */
-        alLink((ALLink*)dmaPtr,(ALLink*)lastDmaPtr);
+        __amDMAUnhash(dmaPtr);
+        if(dmaState.firstUsed == dmaPtr)
+            dmaState.firstUsed = (AMDMABuffer*)dmaPtr->node.next;
+        alUnlink((ALLink*)dmaPtr);
     }
-    else if(dmaState.firstUsed) /* if this buffer is before any others */
-    {                           /* jam at begining of list */ 
-        lastDmaPtr = dmaState.firstUsed;
-        dmaState.firstUsed = dmaPtr;
-        dmaPtr->node.next = (ALLink*)lastDmaPtr;
+
+    /* add it to the used list */
+    if (dmaState.firstUsed)
+    {
+        dmaPtr->node.next = (ALLink*)dmaState.firstUsed;
         dmaPtr->node.prev = 0;
-        lastDmaPtr->node.prev = (ALLink*)dmaPtr;
+        dmaState.firstUsed->node.prev = (ALLink*)dmaPtr;
     }
-    else /* no buffers in list, this is the first one */
+    else
     {
-        dmaState.firstUsed = dmaPtr;
         dmaPtr->node.next = 0;
         dmaPtr->node.prev = 0;
     }
-    
-    foundBuffer = dmaPtr->ptr;
-    delta = addr & 0x1;
-    addr -= delta;
+    dmaState.firstUsed = dmaPtr;
+
+    return dmaPtr;
+}
+
+static void __amDMAStart(AMDMABuffer *dmaPtr, s32 addr)
+{
     dmaPtr->startAddr = addr;
     dmaPtr->lastFrame = audFrameCt;  /* mark it */
+    dmaPtr->hashNext = dmaState.hash[DMA_HASH_INDEX(addr)];
+    dmaState.hash[DMA_HASH_INDEX(addr)] = dmaPtr;
 
     audDMAIOMesgBuf[nextDMA].hdr.pri      = OS_MESG_PRI_NORMAL;
     audDMAIOMesgBuf[nextDMA].hdr.retQueue = &audDMAMessageQ;
-    audDMAIOMesgBuf[nextDMA].dramAddr     = foundBuffer;
+    audDMAIOMesgBuf[nextDMA].dramAddr     = dmaPtr->ptr;
     audDMAIOMesgBuf[nextDMA].devAddr      = (u32)addr;
     audDMAIOMesgBuf[nextDMA].size         = DMA_BUFFER_LENGTH;
 
     osEPiStartDma(gPiHandle, &audDMAIOMesgBuf[nextDMA++], OS_READ);
+}
+
+/* 
+ * a voice reading sequentially will want the data right after this
+ * request next frame, so start loading it now while there are spare buffers
+ */
+static void __amDMAPrefetch(s32 addrEnd)
+{
+    s32             start;
+    AMDMABuffer     *dmaPtr;
+
+    if (nextDMA >= NUM_DMA_MESSAGES || dmaState.freeCount <= DMA_PREFETCH_RESERVE)
+        return;
+
+    start = addrEnd & ~(DMA_BUFFER_ALIGN - 1);
+
+    if (__amDMAFind(addrEnd, addrEnd + DMA_PREFETCH_LENGTH))
+        return;
+
+    dmaPtr = __amDMAAlloc();
+    dmaPtr->prefetched = 1;
+    __amDMAStart(dmaPtr, start);
+    ++gAudioDMAStats.prefetches;
+}
+
+s32 __amDMA(s32 addr, s32 len, void *state)
+{
+    s32             start, addrEnd;
+    AMDMABuffer     *dmaPtr;
+    AMDMAVoiceState *voiceState = (AMDMAVoiceState*)state;
+    
+    addrEnd = addr+len;
+
+    /* first check to see if a currently existing buffer contains the
+       sample that you need.  */
+    dmaPtr = __amDMAFind(addr, addrEnd);
+
+    if (dmaPtr)
+    {
+        dmaPtr->lastFrame = audFrameCt; /* mark it used */
+        ++gAudioDMAStats.hits;
 
-    return (int) osVirtualToPhysical(foundBuffer) + delta;
+        if (dmaPtr->prefetched)
+        {
+            dmaPtr->prefetched = 0;
+            ++gAudioDMAStats.prefetchHits;
+        }
+    }
+    else
+    {
+        /* get here, and you didn't find a buffer, so dma a new one */
+        if (nextDMA >= NUM_DMA_MESSAGES || !(dmaPtr = __amDMAAlloc()))
+        {
+            /* 
+            * if you get here there is nothing left to load into, send
+            * back the a bogus pointer, it's better than nothing
+            */
+            ++gAudioDMAStats.starved;
+            PRINTF("audio: dma starved\n");
+            return osVirtualToPhysical(dmaState.firstUsed);
+        }
+
+        start = addr & ~(DMA_BUFFER_ALIGN - 1);
+
+        /* very long reads wont fit in an aligned buffer */
+        if (start + DMA_BUFFER_LENGTH < addrEnd)
+            start = addr & ~0x1;
+
+        dmaPtr->prefetched = 0;
+        __amDMAStart(dmaPtr, start);
+        ++gAudioDMAStats.misses;
+    }
+
+    if (voiceState)
+    {
+        if (voiceState->nextAddr == addr)
+            __amDMAPrefetch(addrEnd);
+
+        voiceState->nextAddr = addrEnd;
+    }
+
+    return (int) osVirtualToPhysical(dmaPtr->ptr) + addr - dmaPtr->startAddr;
 }
 
-ALDMAproc __amDmaNew(AMDMAState **state)
+ALDMAproc __amDmaNew(AMDMAVoiceState **state)
 {    
     if(!dmaState.initialized)  /* only do this once */
     {
         dmaState.firstUsed = 0;
         dmaState.firstFree = &dmaBuffs[0];
+        dmaState.freeCount = NUM_DMA_BUFFERS;
+        dmaState.nextVoice = 0;
         dmaState.initialized = 1;
     }
 
-    *state = &dmaState;  /* state is never used in this case */
+    if (dmaState.nextVoice < MAX_VOICES)
+    {
+        *state = &dmaVoiceState[dmaState.nextVoice];
+        dmaVoiceState[dmaState.nextVoice].nextAddr = -1;
+        ++dmaState.nextVoice;
+    }
+    else
+    {
+        /* no sequential prefetching without a voice state */
+        *state = 0;
+    }
 
     return __amDMA;
 }
@@ -410,7 +537,9 @@ static void __clearAudioDMA(void)
         {
             if(dmaState.firstUsed == dmaPtr)
                 dmaState.firstUsed = (AMDMABuffer*)dmaPtr->node.next;
+            __amDMAUnhash(dmaPtr);
             alUnlink((ALLink*)dmaPtr);
+            ++dmaState.freeCount;
             if(dmaState.firstFree)
                 alLink((ALLink*)dmaPtr,(ALLink*)dmaState.firstFree);
             else
@@ -19,6 +19,13 @@ ALSndPlayer gSoundPlayer;
 #define SOUND_FLAGS_LOOPING     (1 << 1)
 #define SOUND_HAS_STARTED       (1 << 2)
 #define SOUND_FLAGS_PAUSED      (1 << 3)
+// stopped to free up a synth voice but still keeps time
+#define SOUND_FLAGS_VIRTUAL     (1 << 4)
+#define SOUND_FLAGS_3D_DIRTY    (1 << 5)
+
+// the most sounds the synthesizer mixes at once, the rest become virtual
+#define MAX_AUDIBLE_SOUNDS      8
+#define SOUND_AUDIBLE_THRESHOLD (1.0f / 512.0f)
 
 #define SPEED_OF_SOUND          343.2f
 
@@ -32,6 +39,17 @@ struct ActiveSound {
     float originalVolume;
     float basePitch;
     enum SoundType soundType;
+
+    // 3d results only change when the sound, listener or a portal moves
+    u16 environmentVersion;
+    short pan3D;
+    float volume3D;
+    float pitchBend3D;
+
+    short appliedVolume;
+    short appliedPan;
+    float appliedPitch;
+    float priority;
 };
 
 struct SoundListener {
@@ -46,6 +64,10 @@ int gActiveSoundCount = 0;
 struct SoundListener gSoundListeners[MAX_SOUND_LISTENERS];
 int gActiveListenerCount = 0;
 
+u16 gSoundEnvironmentVersion = 0;
+struct Vector3 gSoundPortalPositions[2];
+int gSoundPortalsPresent = 0;
+
 void soundPlayerDetermine3DSound(struct Vector3* at, struct Vector3* velocity, float* volumeIn, float* volumeOut, int* panOut, float* pitchBend) {
     if (!gActiveListenerCount) {
         *volumeOut = *volumeIn;
@@ -59,14 +81,9 @@ void soundPlayerDetermine3DSound(struct Vector3* at, struct Vector3* velocity, f
     int through_1_from_0 = 0;
 
 
-    int portalsPresent = 0;
-    struct Transform portal0transform;
-    struct Transform portal1transform;
-    if (gCollisionScene.portalTransforms[0] != NULL && gCollisionScene.portalTransforms[1] != NULL){
-        portalsPresent = 1;
-        portal0transform = *gCollisionScene.portalTransforms[0];
-        portal1transform = *gCollisionScene.portalTransforms[1];
-    }
+    int portalsPresent = gSoundPortalsPresent;
+    struct Vector3* portal0position = &gSoundPortalPositions[0];
+    struct Vector3* portal1position = &gSoundPortalPositions[1];
 
     for (int i = 0; i < MAX_SOUND_LISTENERS; ++i) {
         float check = vector3DistSqrd(at, &gSoundListeners[i].worldPos);
@@ -80,8 +97,8 @@ void soundPlayerDetermine3DSound(struct Vector3* at, struct Vector3* velocity, f
         if (portalsPresent){
             float dist1,dist2;
             // check dist from obj to 0 portal + from 1 portal to listener
-            dist1 =  vector3DistSqrd(at, &portal0transform.position);
-            dist2 =  vector3DistSqrd(&portal1transform.position, &gSoundListeners[i].worldPos);
+            dist1 =  vector3DistSqrd(at, portal0position);
+            dist2 =  vector3DistSqrd(portal1position, &gSoundListeners[i].worldPos);
             if ((dist1+dist2) < distance){
                 distance = (dist1+dist2);
                 nearestListener = &gSoundListeners[i];
@@ -89,8 +106,8 @@ void soundPlayerDetermine3DSound(struct Vector3* at, struct Vector3* velocity, f
                 through_1_from_0 = 0;
             }
             // check dist from obj to 1 portal + from 0 portal to listener
-            dist1 =  vector3DistSqrd(at, &portal1transform.position);
-            dist2 =  vector3DistSqrd(&portal0transform.position, &gSoundListeners[i].worldPos);
+            dist1 =  vector3DistSqrd(at, portal1position);
+            dist2 =  vector3DistSqrd(portal0position, &gSoundListeners[i].worldPos);
             if ((dist1+dist2) < distance){
                 distance = (dist1+dist2);
                 nearestListener = &gSoundListeners[i];
@@ -116,10 +133,10 @@ void soundPlayerDetermine3DSound(struct Vector3* at, struct Vector3* velocity, f
 
     struct Vector3 offset;
     if (through_0_from_1){
-        vector3Sub(&portal1transform.position, &nearestListener->worldPos, &offset);
+        vector3Sub(portal1position, &nearestListener->worldPos, &offset);
     }
     else if(through_1_from_0){
-        vector3Sub(&portal0transform.position, &nearestListener->worldPos, &offset);
+        vector3Sub(portal0position, &nearestListener->worldPos, &offset);
     }
     else{
         vector3Sub(at, &nearestListener->worldPos, &offset);
@@ -222,6 +239,8 @@ ALSndId soundPlayerPlay(int soundClipId, float volume, float pitch, struct Vecto
     sound->originalVolume = volume;
     sound->basePitch = pitch;
     sound->soundType = type;
+    sound->environmentVersion = gSoundEnvironmentVersion;
+    sound->priority = 0.0f;
 
     float newVolume = sound->originalVolume * gSaveData.audio.soundVolume/0xFFFF;
     if (type == SoundTypeMusic){
@@ -238,8 +257,16 @@ ALSndId soundPlayerPlay(int soundClipId, float volume, float pitch, struct Vecto
         float pitchBend;
         soundPlayerDetermine3DSound(at, velocity, &newVolume, &newVolume, &panning, &pitchBend);
         pitch = pitch * pitchBend;
+
+        sound->volume3D = newVolume;
+        sound->pan3D = panning;
+        sound->pitchBend3D = pitchBend;
     }
 
+    sound->appliedVolume = (short)(32767 * newVolume);
+    sound->appliedPan = panning;
+    sound->appliedPitch = pitch;
+
     if (soundPlayerIsLooped(alSound)) {
         sound->flags |= SOUND_FLAGS_LOOPING;
     }
@@ -284,22 +311,20 @@ void soundPlayerGameVolumeUpdate() {
             continue;
         }
         if (sound->flags & SOUND_FLAGS_3D){
+            // applied on the next soundPlayerUpdate
             sound->volume = newVolume;
-            float volume;
-            float pitch;
-            int panning;
-            soundPlayerDetermine3DSound(&sound->pos3D, &sound->velocity3D, &sound->volume, &volume, &panning, &pitch);
-            alSndpSetSound(&gSoundPlayer, sound->soundId);
-            alSndpSetVol(&gSoundPlayer, (short)(32767 * volume));
-            alSndpSetPan(&gSoundPlayer, panning);
-            alSndpSetPitch(&gSoundPlayer, sound->basePitch * pitch);
+            sound->flags |= SOUND_FLAGS_3D_DIRTY;
+            sound->appliedVolume = -1;
             ++index;
             continue;
             
         } else {
-            alSndpSetSound(&gSoundPlayer, sound->soundId);
-            alSndpSetVol(&gSoundPlayer, (short)(32767 * newVolume));
             sound->volume = newVolume;
+            sound->appliedVolume = (short)(32767 * newVolume);
+            if (!(sound->flags & SOUND_FLAGS_VIRTUAL)) {
+                alSndpSetSound(&gSoundPlayer, sound->soundId);
+                alSndpSetVol(&gSoundPlayer, sound->appliedVolume);
+            }
             ++index;
             continue;
         }
@@ -308,12 +333,168 @@ void soundPlayerGameVolumeUpdate() {
 
 #define SOUND_DAMPING_LEVEL 0.5f
 
+#define SOUND_PRIORITY_VOICE    4.0f
+#define SOUND_PRIORITY_MUSIC    2.0f
+
+void soundPlayerCheckPortals() {
+    int portalsPresent = gCollisionScene.portalTransforms[0] != NULL && gCollisionScene.portalTransforms[1] != NULL;
+
+    if (portalsPresent != gSoundPortalsPresent) {
+        gSoundPortalsPresent = portalsPresent;
+        ++gSoundEnvironmentVersion;
+    }
+
+    if (!portalsPresent) {
+        return;
+    }
+
+    for (int i = 0; i < 2; ++i) {
+        struct Vector3* position = &gCollisionScene.portalTransforms[i]->position;
+
+        if (!vector3Equals(position, &gSoundPortalPositions[i])) {
+            gSoundPortalPositions[i] = *position;
+            ++gSoundEnvironmentVersion;
+        }
+    }
+}
+
+float soundPlayerAudibleVolume(struct ActiveSound* sound, float soundDamping) {
+    if (!(sound->flags & SOUND_FLAGS_3D)) {
+        return sound->volume;
+    }
+
+    if ((sound->flags & SOUND_FLAGS_3D_DIRTY) || sound->environmentVersion != gSoundEnvironmentVersion) {
+        int panning;
+        soundPlayerDetermine3DSound(&sound->pos3D, &sound->velocity3D, &sound->volume, &sound->volume3D, &panning, &sound->pitchBend3D);
+        sound->pan3D = panning;
+        sound->environmentVersion = gSoundEnvironmentVersion;
+        sound->flags &= ~SOUND_FLAGS_3D_DIRTY;
+    }
+
+    if (sound->soundType != SoundTypeVoice) {
+        return sound->volume3D * soundDamping;
+    }
+
+    return sound->volume3D;
+}
+
+void soundPlayerApply3D(struct ActiveSound* sound, float volume) {
+    short volumeInt = (short)(32767 * volume);
+    float pitch = sound->basePitch * sound->pitchBend3D;
+
+    if (volumeInt != sound->appliedVolume) {
+        alSndpSetVol(&gSoundPlayer, volumeInt);
+        sound->appliedVolume = volumeInt;
+    }
+
+    if (sound->pan3D != sound->appliedPan) {
+        alSndpSetPan(&gSoundPlayer, sound->pan3D);
+        sound->appliedPan = sound->pan3D;
+    }
+
+    if (pitch != sound->appliedPitch) {
+        alSndpSetPitch(&gSoundPlayer, pitch);
+        sound->appliedPitch = pitch;
+    }
+}
+
+int soundPlayerIsProtected(struct ActiveSound* sound) {
+    return sound->soundType == SoundTypeVoice || sound->soundType == SoundTypeMusic;
+}
+
+void soundPlayerSchedule(float soundDamping) {
+    float volumes[MAX_ACTIVE_SOUNDS];
+
+    for (int i = 0; i < gActiveSoundCount; ++i) {
+        struct ActiveSound* sound = &gActiveSounds[i];
+
+        if (sound->flags & SOUND_FLAGS_PAUSED) {
+            continue;
+        }
+
+        volumes[i] = soundPlayerAudibleVolume(sound, soundDamping);
+
+        sound->priority = volumes[i];
+
+        if (sound->soundType == SoundTypeVoice) {
+            sound->priority += SOUND_PRIORITY_VOICE;
+        } else if (sound->soundType == SoundTypeMusic) {
+            sound->priority += SOUND_PRIORITY_MUSIC;
+        }
+    }
+
+    for (int i = 0; i < gActiveSoundCount; ++i) {
+        struct ActiveSound* sound = &gActiveSounds[i];
+
+        if (sound->flags & SOUND_FLAGS_PAUSED) {
+            continue;
+        }
+
+        int rank = 0;
+
+        for (int j = 0; j < gActiveSoundCount; ++j) {
+            struct ActiveSound* other = &gActiveSounds[j];
+
+            if (j == i || (other->flags & SOUND_FLAGS_PAUSED)) {
+                continue;
+            }
+
+            if (other->priority > sound->priority || (other->priority == sound->priority && j < i)) {
+                ++rank;
+            }
+        }
+
+        int shouldBeAudible = soundPlayerIsProtected(sound) || 
+            (rank < MAX_AUDIBLE_SOUNDS && volumes[i] >= SOUND_AUDIBLE_THRESHOLD);
+
+        alSndpSetSound(&gSoundPlayer, sound->soundId);
+
+        if (!shouldBeAudible) {
+            if (!(sound->flags & SOUND_FLAGS_VIRTUAL)) {
+                alSndpStop(&gSoundPlayer);
+                sound->flags |= SOUND_FLAGS_VIRTUAL;
+            }
+            continue;
+        }
+
+        if (sound->flags & SOUND_FLAGS_VIRTUAL) {
+            // a one shot sound can't resume where it would have been
+            // so it stays virtual until its time runs out
+            if (!(sound->flags & SOUND_FLAGS_LOOPING) || alSndpGetState(&gSoundPlayer) != AL_STOPPED) {
+                continue;
+            }
+
+            sound->flags &= ~SOUND_FLAGS_VIRTUAL;
+            sound->appliedVolume = -1;
+            sound->appliedPan = -1;
+            sound->appliedPitch = -1.0f;
+
+            if (sound->flags & SOUND_FLAGS_3D) {
+                soundPlayerApply3D(sound, volumes[i]);
+            } else {
+                alSndpSetVol(&gSoundPlayer, (short)(32767 * sound->volume));
+                alSndpSetPitch(&gSoundPlayer, sound->basePitch);
+                sound->appliedVolume = (short)(32767 * sound->volume);
+            }
+
+            alSndpPlay(&gSoundPlayer);
+            continue;
+        }
+
+        if (sound->flags & SOUND_FLAGS_3D) {
+            soundPlayerApply3D(sound, volumes[i]);
+        }
+    }
+}
+
 void soundPlayerUpdate() {
     int index = 0;
     int writeIndex = 0;
     int isVoiceActive = 0;
     static float soundDamping = 1.0f;
 
+    soundPlayerCheckPortals();
+
     while (index < gActiveSoundCount) {
         struct ActiveSound* sound = &gActiveSounds[index];
 
@@ -333,7 +514,15 @@ void soundPlayerUpdate() {
 
         int soundState = alSndpGetState(&gSoundPlayer);
 
-        if (soundState == AL_STOPPED && (sound->flags & SOUND_HAS_STARTED) != 0) {
+        int isFinished;
+
+        if (sound->flags & SOUND_FLAGS_VIRTUAL) {
+            isFinished = soundState == AL_STOPPED && sound->estimatedTimeLeft < 0.0f;
+        } else {
+            isFinished = soundState == AL_STOPPED && (sound->flags & SOUND_HAS_STARTED) != 0;
+        }
+
+        if (isFinished) {
             alSndpDeallocate(&gSoundPlayer, sound->soundId);
             sound->soundId = SOUND_ID_NONE;
         } else {
@@ -341,23 +530,6 @@ void soundPlayerUpdate() {
                 sound->flags |= SOUND_HAS_STARTED;
             }
 
-            if (sound->flags & SOUND_FLAGS_3D) {
-                float volume;
-                float pitch;
-                int panning;
-
-                soundPlayerDetermine3DSound(&sound->pos3D, &sound->velocity3D, &sound->volume, &volume, &panning, &pitch);
-
-                if (sound->soundType != SoundTypeVoice) {
-                    volume *= soundDamping;
-                }
-
-                alSndpSetVol(&gSoundPlayer, (short)(32767 * volume));
-                alSndpSetPan(&gSoundPlayer, panning);
-                alSndpSetPitch(&gSoundPlayer, sound->basePitch * pitch);
-            }
-
-
             ++writeIndex;
         }
         
@@ -371,6 +543,8 @@ void soundPlayerUpdate() {
     soundDamping = mathfMoveTowards(soundDamping, isVoiceActive ? SOUND_DAMPING_LEVEL : 1.0f, FIXED_DELTA_TIME);
 
     gActiveSoundCount = writeIndex;
+
+    soundPlayerSchedule(soundDamping);
 }
 
 struct ActiveSound* soundPlayerFindActiveSound(ALSndId soundId) {
@@ -413,9 +587,13 @@ void soundPlayerUpdatePosition(ALSndId soundId, struct Vector3* at, struct Vecto
     struct ActiveSound* activeSound = soundPlayerFindActiveSound(soundId);
 
     if (activeSound) {
-        activeSound->flags |= SOUND_FLAGS_3D;
-        activeSound->pos3D = *at;
-        activeSound->velocity3D = *velocity;
+        if (!(activeSound->flags & SOUND_FLAGS_3D) || 
+            !vector3Equals(&activeSound->pos3D, at) || 
+            !vector3Equals(&activeSound->velocity3D, velocity)) {
+            activeSound->flags |= SOUND_FLAGS_3D | SOUND_FLAGS_3D_DIRTY;
+            activeSound->pos3D = *at;
+            activeSound->velocity3D = *velocity;
+        }
     }
 }
 
@@ -428,15 +606,22 @@ void soundPlayerAdjustVolume(ALSndId soundId, float newVolume) {
             newVolume = newVolume * gSaveData.audio.musicVolume/0xFFFF;
         }
         if (activeSound->flags & SOUND_FLAGS_3D){
-            activeSound->volume = newVolume;
+            if (activeSound->volume != newVolume) {
+                activeSound->volume = newVolume;
+                activeSound->flags |= SOUND_FLAGS_3D_DIRTY;
+            }
         } else {
             short newVolumeInt = (short)(32767 * newVolume);
             short existingVolume = (short)(32767 * activeSound->volume);
 
             if (newVolumeInt != existingVolume) {
-                alSndpSetSound(&gSoundPlayer, activeSound->soundId);
-                alSndpSetVol(&gSoundPlayer, newVolumeInt);
                 activeSound->volume = newVolume;
+                activeSound->appliedVolume = newVolumeInt;
+
+                if (!(activeSound->flags & SOUND_FLAGS_VIRTUAL)) {
+                    alSndpSetSound(&gSoundPlayer, activeSound->soundId);
+                    alSndpSetVol(&gSoundPlayer, newVolumeInt);
+                }
             }
         }
     }
@@ -453,6 +638,10 @@ int soundPlayerIsPlaying(ALSndId soundId) {
         return 1;
     }
 
+    if (activeSound->flags & SOUND_FLAGS_VIRTUAL) {
+        return activeSound->estimatedTimeLeft > 0.0f;
+    }
+
     alSndpSetSound(&gSoundPlayer, soundId);
     return activeSound->estimatedTimeLeft > 0.0f && alSndpGetState(&gSoundPlayer) != AL_STOPPED;
 }
@@ -482,12 +671,26 @@ float soundPlayerTimeLeft(ALSndId soundId) {
 }
 
 void soundListenerUpdate(struct Vector3* position, struct Quaternion* rotation, struct Vector3* velocity, int listenerIndex) {
-    gSoundListeners[listenerIndex].worldPos = *position;
-    gSoundListeners[listenerIndex].velocity = *velocity;
-    quatMultVector(rotation, &gRight, &gSoundListeners[listenerIndex].rightVector);
+    struct SoundListener* listener = &gSoundListeners[listenerIndex];
+    struct Vector3 rightVector;
+    quatMultVector(rotation, &gRight, &rightVector);
+
+    if (vector3Equals(&listener->worldPos, position) && 
+        vector3Equals(&listener->velocity, velocity) && 
+        vector3Equals(&listener->rightVector, &rightVector)) {
+        return;
+    }
+
+    listener->worldPos = *position;
+    listener->velocity = *velocity;
+    listener->rightVector = rightVector;
+    ++gSoundEnvironmentVersion;
 }
 
 void soundListenerSetCount(int count) {
+    if (count != gActiveListenerCount) {
+        ++gSoundEnvironmentVersion;
+    }
     gActiveListenerCount = count;
 }
 
@@ -510,6 +713,14 @@ void soundPlayerResume() {
         if (activeSound->flags & SOUND_FLAGS_PAUSED) {
             activeSound->flags &= ~SOUND_FLAGS_PAUSED;
 
+            // force the scheduler to send the volume and pitch again
+            activeSound->appliedVolume = -1;
+            activeSound->appliedPitch = -1.0f;
+
+            if (activeSound->flags & SOUND_FLAGS_VIRTUAL) {
+                continue;
+            }
+
             alSndpSetSound(&gSoundPlayer, activeSound->soundId);
             alSndpSetPitch(&gSoundPlayer, activeSound->basePitch);
             alSndpSetVol(&gSoundPlayer, (short)(32767 * activeSound->volume));
@@ -100,6 +100,7 @@ void decorObjectInit(struct DecorObject* object, struct DecorObjectDefinition* d
     object->dynamicId = dynamicSceneAdd(object, decorObjectRender, &object->rigidBody.transform.position, definition->radius);
 
     dynamicSceneSetRoomFlags(object->dynamicId, ROOM_FLAG_FROM_INDEX(room));
+    object->flagsRoom = room;
 
     object->playingSound = SOUND_ID_NONE;
 }
@@ -148,7 +149,40 @@ enum FizzleCheckResult decorObjectUpdateFizzler(struct CollisionObject* collisio
     return result;
 }
 
+void decorObjectUpdateRoomFlags(struct DecorObject* decorObject) {
+    if (decorObject->flagsRoom != decorObject->rigidBody.currentRoom) {
+        dynamicSceneSetRoomFlags(decorObject->dynamicId, ROOM_FLAG_FROM_INDEX(decorObject->rigidBody.currentRoom));
+        decorObject->flagsRoom = decorObject->rigidBody.currentRoom;
+    }
+}
+
+// a sleeping object that isn't fizzling, making noise or
+// being stood on has nothing to update
+int decorObjectIsResting(struct DecorObject* decorObject) {
+    if (decorObject->collisionObject.body && !(decorObject->rigidBody.flags & RigidBodyIsSleeping)) {
+        return 0;
+    }
+
+    if ((decorObject->rigidBody.flags & RigidBodyFizzled) || 
+        (decorObject->collisionObject.flags & COLLISION_OBJECT_PLAYER_STANDING) ||
+        decorObject->playingSound != SOUND_ID_NONE) {
+        return 0;
+    }
+
+    // would start playing its sound
+    return decorObject->definition->soundClipId == -1 || 
+        decorObject->fizzleTime != 0.0f || 
+        (decorObject->definition->flags & DecorObjectFlagsMuted);
+}
+
 int decorObjectUpdate(struct DecorObject* decorObject) {
+    // a restored save can have a sleeping object outside the room it spawned in
+    decorObjectUpdateRoomFlags(decorObject);
+
+    if (decorObjectIsResting(decorObject)) {
+        return 1;
+    }
+
     if (decorObject->collisionObject.flags & COLLISION_OBJECT_PLAYER_STANDING) {
         decorObject->collisionObject.flags &= ~COLLISION_OBJECT_PLAYER_STANDING;
     }
@@ -175,7 +209,7 @@ int decorObjectUpdate(struct DecorObject* decorObject) {
     } else if (fizzleResult == FizzleCheckResultEnd) {
         if (decorObject->definition->flags & DecorObjectFlagsImportant) {
             decorObjectReset(decorObject);
-            dynamicSceneSetRoomFlags(decorObject->dynamicId, ROOM_FLAG_FROM_INDEX(decorObject->rigidBody.currentRoom));
+            decorObjectUpdateRoomFlags(decorObject);
             return 1;
         }
 
@@ -190,7 +224,7 @@ int decorObjectUpdate(struct DecorObject* decorObject) {
         decorObject->playingSound = soundPlayerPlay(decorObject->definition->soundClipId, 0.5f, 1.0f, &decorObject->rigidBody.transform.position, &decorObject->rigidBody.velocity, SoundTypeAll);
     }
 
-    dynamicSceneSetRoomFlags(decorObject->dynamicId, ROOM_FLAG_FROM_INDEX(decorObject->rigidBody.currentRoom));
+    decorObjectUpdateRoomFlags(decorObject);
 
     return 1;
 }
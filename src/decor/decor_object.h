@@ -32,6 +32,8 @@ struct DecorObject {
     struct Vector3 originalPosition;
     struct Quaternion originalRotation;
     short originalRoom;
+    // room the dynamic scene flags were last set for
+    short flagsRoom;
     short dynamicId;
     ALSndId playingSound;
     float fizzleTime;
@@ -10,6 +10,7 @@
 
 #define HIGH_RES    0
 
+#define SAVE_PRIORITY		9
 #define INIT_PRIORITY		10
 #define GAME_PRIORITY		10
 #define CONTROLLER_PRIORITY 11
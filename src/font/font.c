@@ -25,7 +25,7 @@ int fontDetermineKerning(struct Font* font, short first, short second) {
     return 0;
 }
 
-struct FontSymbol* fontFindSymbol(struct Font* font, short id) {
+struct FontSymbol* fontFindSymbolHashed(struct Font* font, short id) {
     unsigned index = ((unsigned)id * (unsigned)font->symbolMultiplier) & (unsigned)font->symbolMask;
     int maxIterations = font->symbolMaxCollisions;
 
@@ -47,6 +47,40 @@ struct FontSymbol* fontFindSymbol(struct Font* font, short id) {
     return NULL;
 }
 
+struct FontSymbol* fontFindSymbol(struct Font* font, short id) {
+    unsigned page = (unsigned short)id >> FONT_GLYPH_PAGE_SHIFT;
+
+    if (font->glyphPages && page < font->glyphPageCount) {
+        unsigned pageIndex = font->glyphPages[page];
+
+        if (pageIndex != FONT_GLYPH_NO_PAGE) {
+            int symbolIndex = font->glyphIndices[(pageIndex << FONT_GLYPH_PAGE_SHIFT) | (id & FONT_GLYPH_PAGE_MASK)];
+            return symbolIndex < 0 ? NULL : &font->symbols[symbolIndex];
+        }
+    }
+
+    return fontFindSymbolHashed(font, id);
+}
+
+int fontSymbolKerning(struct Font* font, struct FontSymbol* first, struct FontSymbol* second) {
+    if (!first) {
+        return 0;
+    }
+
+    if (!font->kerningMatrix) {
+        return fontDetermineKerning(font, first->id, second->id);
+    }
+
+    int row = font->kerningRows[first - font->symbols];
+    int column = font->kerningColumns[second - font->symbols];
+
+    if (!row || !column) {
+        return 0;
+    }
+
+    return font->kerningMatrix[(row - 1) * font->kerningColumnCount + column - 1];
+}
+
 short fontNextUtf8Character(char** strPtr) {
     char* curr = *strPtr;
 
@@ -103,14 +137,13 @@ void fontRendererLayout(struct FontRenderer* renderer, struct Font* font, char*
     renderer->currentSymbol = 0;
     renderer->usedImageIndices = 0;
 
-    short prev = 0;
+    struct FontSymbol* prev = NULL;
     short curr = 0;
     int x = 0;
     int y = 0;
     int currentMaxWidth = 0;
 
     while (*message && renderer->currentSymbol < FONT_RENDERER_MAX_SYBMOLS) {
-        prev = curr;
         // also advances message to the next character
         curr = fontNextUtf8Character(&message);
 
@@ -118,16 +151,19 @@ void fontRendererLayout(struct FontRenderer* renderer, struct Font* font, char*
             currentMaxWidth = MAX(currentMaxWidth, x);
             y += font->charHeight;
             x = 0;
+            prev = NULL;
             continue;
         }
 
         struct FontSymbol* symbol = fontFindSymbol(font, curr);
 
         if (!symbol) {
+            prev = NULL;
             continue;
         }
 
-        x += fontDetermineKerning(font, prev, curr);
+        x += fontSymbolKerning(font, prev, symbol);
+        prev = symbol;
 
         struct SymbolLocation* target = &renderer->symbols[renderer->currentSymbol];
 
@@ -166,6 +202,52 @@ void fontRendererLayout(struct FontRenderer* renderer, struct Font* font, char*
     renderer->height = y + font->charHeight;
 }
 
+#define FONT_LAYOUT_CACHE_SIZE  2
+
+struct FontLayoutCacheEntry {
+    struct Font* font;
+    char* message;
+    short maxWidth;
+    unsigned short lastUsed;
+    struct FontRenderer renderer;
+};
+
+struct FontLayoutCacheEntry gFontLayoutCache[FONT_LAYOUT_CACHE_SIZE];
+unsigned short gFontLayoutCacheTime;
+
+struct FontRenderer* fontRendererLayoutCached(struct Font* font, char* message, int maxWidth) {
+    struct FontLayoutCacheEntry* oldest = &gFontLayoutCache[0];
+
+    ++gFontLayoutCacheTime;
+
+    for (int i = 0; i < FONT_LAYOUT_CACHE_SIZE; ++i) {
+        struct FontLayoutCacheEntry* entry = &gFontLayoutCache[i];
+
+        if (entry->message == message && entry->font == font && entry->maxWidth == maxWidth) {
+            entry->lastUsed = gFontLayoutCacheTime;
+            return &entry->renderer;
+        }
+
+        if ((unsigned short)(gFontLayoutCacheTime - entry->lastUsed) > (unsigned short)(gFontLayoutCacheTime - oldest->lastUsed)) {
+            oldest = entry;
+        }
+    }
+
+    fontRendererLayout(&oldest->renderer, font, message, maxWidth);
+    oldest->font = font;
+    oldest->message = message;
+    oldest->maxWidth = maxWidth;
+    oldest->lastUsed = gFontLayoutCacheTime;
+
+    return &oldest->renderer;
+}
+
+void fontRendererClearLayoutCache() {
+    for (int i = 0; i < FONT_LAYOUT_CACHE_SIZE; ++i) {
+        gFontLayoutCache[i].message = NULL;
+    }
+}
+
 Gfx* fontRendererBuildSingleGfx(struct FontRenderer* renderer, int imageIndex, int x, int y, Gfx* gfx) {
     for (int i = 0; i < renderer->currentSymbol; ++i) {
         struct SymbolLocation* target = &renderer->symbols[i];
@@ -227,6 +309,9 @@ void fontRendererInitPrerender(struct FontRenderer* renderer, struct Prerendered
     prerender->usedImageIndices = renderer->usedImageIndices;
     prerender->x = 0;
     prerender->y = 0;
+    prerender->renderedX = 0;
+    prerender->renderedY = 0;
+    prerender->colorState = PRERENDERED_COLOR_UNKNOWN;
 
     imageMask = renderer->usedImageIndices;
     imageIndex = 0;
@@ -261,7 +346,7 @@ void fontRendererInitPrerender(struct FontRenderer* renderer, struct Prerendered
 }
 
 struct PrerenderedText* prerenderedTextNew(struct FontRenderer* renderer) {
-    struct PrerenderedText* result = malloc(sizeof(struct PrerenderedText*));
+    struct PrerenderedText* result = malloc(sizeof(struct PrerenderedText));
     fontRendererInitPrerender(renderer, result);
     return result;
 }
@@ -283,6 +368,10 @@ struct PrerenderedText* prerenderedTextCopy(struct PrerenderedText* text) {
     result->y = text->y;
     result->width = text->width;
     result->height = text->height;
+    result->renderedX = text->renderedX;
+    result->renderedY = text->renderedY;
+    result->color = text->color;
+    result->colorState = text->colorState;
 
     imageIndex = 0;
     imageMask = text->usedImageIndices;
@@ -366,49 +455,95 @@ void prerenderShiftSingleSymbol(Gfx* gfx, int xOffset, int yOffset) {
 }
 
 void prerenderedTextRelocate(struct PrerenderedText* prerender, int x, int y) {
+    // texture rectangles are in screen space so they can't be moved
+    // with a matrix, instead the move is applied once the text is drawn
+    // so layout code can move the text around as much as it likes
+    prerender->x = x;
+    prerender->y = y;
+}
+
+static int prerenderedTextColorMatches(struct PrerenderedText* prerender, struct Coloru8* color) {
+    if (!color) {
+        return prerender->colorState == PRERENDERED_COLOR_NONE;
+    }
+
+    return prerender->colorState == PRERENDERED_COLOR_SET &&
+        prerender->color.r == color->r &&
+        prerender->color.g == color->g &&
+        prerender->color.b == color->b &&
+        prerender->color.a == color->a;
+}
+
+static void prerenderedTextWriteColor(struct PrerenderedText* prerender, Gfx* gfx, struct Coloru8* color) {
+    if (color) {
+        gDPPipeSync(gfx++);
+        gDPSetEnvColor(gfx++, color->r, color->g, color->b, color->a);
+        prerender->color = *color;
+        prerender->colorState = PRERENDERED_COLOR_SET;
+    } else {
+        gDPNoOp(gfx++);
+        gDPNoOp(gfx++);
+        prerender->colorState = PRERENDERED_COLOR_NONE;
+    }
+}
+
+static void prerenderedTextUpdate(struct PrerenderedText* prerender, struct Coloru8* color) {
+    int needsMove = prerender->renderedX != prerender->x || prerender->renderedY != prerender->y;
+    int needsColor = !prerenderedTextColorMatches(prerender, color);
+
+    if (!needsMove && !needsColor) {
+        return;
+    }
+
     int imageIndex = 0;
     int imageMask = prerender->usedImageIndices;
 
-    int xOffset = (x - prerender->x) << 2;
-    int yOffset = (y - prerender->y) << 2;
+    int xOffset = (prerender->x - prerender->renderedX) << 2;
+    int yOffset = (prerender->y - prerender->renderedY) << 2;
 
     while (imageMask) {
         if (imageMask & 0x1) {
             Gfx* gfx = prerender->displayLists[imageIndex];
-            // skip color
-            gfx += 2;
+            int size = sizeof(Gfx) * 2;
 
-            while (_SHIFTR(gfx->words.w0, 24, 8) != G_ENDDL) {
-                prerenderShiftSingleSymbol(gfx, xOffset, yOffset);
-                gfx += 3;
+            if (needsColor) {
+                prerenderedTextWriteColor(prerender, gfx, color);
             }
 
-            osWritebackDCache(prerender->displayLists[imageIndex], (int)gfx - (int)prerender->displayLists[imageIndex]);
+            if (needsMove) {
+                // skip color
+                gfx += 2;
+
+                while (_SHIFTR(gfx->words.w0, 24, 8) != G_ENDDL) {
+                    prerenderShiftSingleSymbol(gfx, xOffset, yOffset);
+                    gfx += 3;
+                }
+
+                size = (int)gfx - (int)prerender->displayLists[imageIndex];
+            }
+
+            osWritebackDCache(prerender->displayLists[imageIndex], size);
         }
 
         imageMask >>= 1;
         ++imageIndex;
     }
-    prerender->x = x;
-    prerender->y = y;
+
+    prerender->renderedX = prerender->x;
+    prerender->renderedY = prerender->y;
 }
 
 void prerenderedTextRecolor(struct PrerenderedText* prerender, struct Coloru8* color) {
+    if (prerenderedTextColorMatches(prerender, color)) {
+        return;
+    }
+
     int imageIndex = 0;
     int imageMask = prerender->usedImageIndices;
 
     while (imageMask) {
         if (imageMask & 0x1) {
-            Gfx* gfx = prerender->displayLists[imageIndex];
-
-            if (color) {
-                gDPPipeSync(gfx++);
-                gDPSetEnvColor(gfx++, color->r, color->g, color->b, color->a);
-            } else {
-                gDPNoOp(gfx++);
-                gDPNoOp(gfx++);
-            }
-
+            prerenderedTextWriteColor(prerender, prerender->displayLists[imageIndex], color);
             osWritebackDCache(prerender->displayLists[imageIndex], sizeof(Gfx) * 2);
         }
 
@@ -423,20 +558,18 @@ void fontRendererFillPrerender(struct FontRenderer* renderer, struct Prerendered
 
     prerender->x = x;
     prerender->y = y;
+    prerender->renderedX = x;
+    prerender->renderedY = y;
     prerender->width = renderer->width;
     prerender->height = renderer->height;
+    prerender->colorState = PRERENDERED_COLOR_UNKNOWN;
 
     while (imageMask) {
         if (imageMask & 0x1) {
             Gfx* gfx = prerender->displayLists[imageIndex];
 
-            if (color) {
-                gDPPipeSync(gfx++);
-                gDPSetEnvColor(gfx++, color->r, color->g, color->b, color->a);
-            } else {
-                gDPNoOp(gfx++);
-                gDPNoOp(gfx++);
-            }
+            prerenderedTextWriteColor(prerender, gfx, color);
+            gfx += 2;
             gfx = fontRendererBuildSingleGfx(renderer, imageIndex, x, y, gfx);
             gSPEndDisplayList(gfx++);
 
@@ -459,7 +592,7 @@ void prerenderedBatchAdd(struct PrerenderedTextBatch* batch, struct PrerenderedT
     if (batch->textCount >= MAX_PRERENDERED_STRINGS) {
         return;
     }
-    prerenderedTextRecolor(text, color);
+    prerenderedTextUpdate(text, color);
     batch->text[batch->textCount] = text;
     ++batch->textCount;
     batch->usedImageIndices |= text->usedImageIndices;
@@ -33,8 +33,25 @@ struct Font {
     unsigned short kerningMultiplier;
     unsigned short kerningMask;
     unsigned short kerningMaxCollisions;
+
+    // optional direct lookup tables generated by font_converter.js
+    // codepoints on pages without an entry fall back to the hash tables
+    unsigned char* glyphPages;
+    short* glyphIndices;
+    unsigned short glyphPageCount;
+
+    // indexed by symbol, 0 means the symbol has no kerning pairs
+    unsigned char* kerningRows;
+    unsigned char* kerningColumns;
+    signed char* kerningMatrix;
+    unsigned short kerningColumnCount;
 };
 
+#define FONT_GLYPH_PAGE_SHIFT   6
+#define FONT_GLYPH_PAGE_SIZE    (1 << FONT_GLYPH_PAGE_SHIFT)
+#define FONT_GLYPH_PAGE_MASK    (FONT_GLYPH_PAGE_SIZE - 1)
+#define FONT_GLYPH_NO_PAGE      0xFF
+
 struct SymbolLocation {
     short x;
     short y;
@@ -57,8 +74,16 @@ struct FontRenderer {
 };
 
 void fontRendererLayout(struct FontRenderer* renderer, struct Font* font, char* message, int maxWidth);
+// the result is only valid until the next call, message must not change while
+// it is cached, call fontRendererClearLayoutCache if it could
+struct FontRenderer* fontRendererLayoutCached(struct Font* font, char* message, int maxWidth);
+void fontRendererClearLayoutCache();
 Gfx* fontRendererBuildGfx(struct FontRenderer* renderer, Gfx** fontImages, int x, int y, struct Coloru8* color, Gfx* gfx);
 
+#define PRERENDERED_COLOR_UNKNOWN   0
+#define PRERENDERED_COLOR_NONE      1
+#define PRERENDERED_COLOR_SET       2
+
 struct PrerenderedText {
     Gfx** displayLists;
     short usedImageIndices;
@@ -66,6 +91,12 @@ struct PrerenderedText {
     short y;
     short width;
     short height;
+    // where the texture rectangles currently are, they
+    // are only moved to x, y when added to a batch
+    short renderedX;
+    short renderedY;
+    struct Coloru8 color;
+    char colorState;
 };
 
 void fontRendererInitPrerender(struct FontRenderer* renderer, struct PrerenderedText* prerender);
@@ -2059,6 +2059,21 @@ struct FontSymbol gLiberationMonoSymbols[] = {
     },
 };
 
+unsigned char gLiberationMonoGlyphPages[] = {
+    0, 1,
+};
+
+short gLiberationMonoGlyphIndices[] = {
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    32, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47,
+    48, 49, 50, 51, 52, 53, 54, 55, 56, 57, 58, 59, 60, 61, 62, 63,
+    64, 65, 66, 67, 68, 69, 70, 71, 72, 73, 74, 75, 76, 77, 78, 79,
+    80, 81, 82, 83, 84, 85, 86, 87, 88, 89, 90, 91, 92, 93, 94, 95,
+    96, 97, 98, 99, 100, 101, 102, 103, 104, 105, 106, 107, 108, 109, 110, 111,
+    112, 113, 114, 115, 116, 117, 118, 119, 120, 121, 122, 123, 124, 125, 126, -1,
+};
+
 struct Font gLiberationMonoFont = {
     .kerning = &gLiberationMonoKerning[0],
     .symbols = &gLiberationMonoSymbols[0],
@@ -2070,5 +2085,12 @@ struct Font gLiberationMonoFont = {
     .kerningMultiplier = 1,
     .kerningMask = 0x1,
     .kerningMaxCollisions = 0,
+    .glyphPages = &gLiberationMonoGlyphPages[0],
+    .glyphIndices = &gLiberationMonoGlyphIndices[0],
+    .glyphPageCount = 2,
+    .kerningRows = NULL,
+    .kerningColumns = NULL,
+    .kerningMatrix = NULL,
+    .kerningColumnCount = 0,
 };
 
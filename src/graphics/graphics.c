@@ -29,6 +29,7 @@ u64* rdpOutput;
 u64 __attribute__((aligned(16))) dram_stack[SP_DRAM_STACK_SIZE64 + 1];
 u64 __attribute__((aligned(16))) gfxYieldBuf2[OS_YIELD_DATA_SIZE/sizeof(u64)];
 u32 firsttime = 1;
+u32 gGraphicsTaskUsec;
 
 u16 __attribute__((aligned(64))) zbuffer[SCREEN_HT * SCREEN_WD];
 
@@ -129,9 +130,19 @@ void graphicsCreateTask(struct GraphicsTask* targetTask, GraphicsCallback callba
 #endif // PORTAL64_WITH_DEBUGGER
 #endif // PORTAL64_WITH_GFX_VALIDATOR
 
+    targetTask->submitTime = osGetTime();
     osSendMesg(schedulerCommandQueue, (OSMesg)scTask, OS_MESG_BLOCK);
 }
 
+void graphicsTaskFinished(OSScMsg* msg) {
+    for (int i = 0; i < 2; ++i) {
+        if (msg == &gGraphicsTasks[i].msg) {
+            gGraphicsTaskUsec = OS_CYCLES_TO_USEC(osGetTime() - gGraphicsTasks[i].submitTime);
+            return;
+        }
+    }
+}
+
 void graphicsTaskClearZBuffer(struct GraphicsTask* task, int minX, int minY, int maxX, int maxY) {
     if (minX >= maxX || minY >= maxY) {
         return;
@@ -20,9 +20,12 @@ struct GraphicsTask {
     OSScMsg msg;
     u16 *framebuffer;
     u16 taskIndex;
+    OSTime submitTime;
 };
 
 extern struct GraphicsTask gGraphicsTasks[2];
+// time between submitting the last finished task and it finishing
+extern u32 gGraphicsTaskUsec;
 extern Vp fullscreenViewport;
 
 extern void* gLevelSegment;
@@ -33,6 +36,7 @@ typedef void (*GraphicsCallback)(void* data, struct RenderState* renderState, st
 
 u16* graphicsLayoutScreenBuffers(u16* memoryEnd);
 void graphicsCreateTask(struct GraphicsTask* targetTask, GraphicsCallback callback, void* data);
+void graphicsTaskFinished(OSScMsg* msg);
 
 void graphicsTaskClearZBuffer(struct GraphicsTask* task, int minX, int minY, int maxX, int maxY);
 
@@ -27,6 +27,11 @@ struct CutsceneRunner* gRunningCutscenes;
 struct CutsceneRunner* gUnusedRunners;
 u64 gTriggeredCutscenes;
 
+// estimated time from each step to the end of its cutscene. Built
+// when the level loads so estimates don't need to walk the steps
+float* gCutsceneStepTimeLeft;
+u16* gCutsceneStepTimeOffset;
+
 #define MAX_QUEUE_LENGTH    25
 
 struct QueuedSound {
@@ -269,8 +274,11 @@ void cutsceneRunnerStartStep(struct CutsceneRunner* runner) {
             break;
         }
         case CutsceneStepTypeGoto:
-            runner->currentStep += step->gotoStep.relativeInstructionIndex;
-            cutsceneRunnerStartStep(runner);
+            runner->currentStep = step->gotoStep.stepIndex;
+
+            if (cutsceneRunnerIsRunning(runner)) {
+                cutsceneRunnerStartStep(runner);
+            }
             break;
         case CutsceneStepTypeStartCutscene:
             cutsceneStart(&gCurrentLevel->cutscenes[step->cutscene.cutsceneIndex]);
@@ -554,14 +562,46 @@ void cutscenesUpdate() {
     }
 }
 
-float cutsceneRunnerEstimateTimeLeft(struct CutsceneRunner* cutsceneRunner) {
-    float result = 0.0f;
+void cutscenesBuildTimeEstimates() {
+    int totalSteps = 0;
 
-    for (int i = cutsceneRunner->currentStep; i < cutsceneRunner->currentCutscene->stepCount; ++i) {
-        result += cutsceneStepEstimateTime(&cutsceneRunner->currentCutscene->steps[i], i == cutsceneRunner->currentStep ? &cutsceneRunner->state : NULL);
+    for (int i = 0; i < gCurrentLevel->cutsceneCount; ++i) {
+        totalSteps += gCurrentLevel->cutscenes[i].stepCount + 1;
     }
 
-    return result;
+    gCutsceneStepTimeLeft = malloc(sizeof(float) * totalSteps);
+    gCutsceneStepTimeOffset = malloc(sizeof(u16) * gCurrentLevel->cutsceneCount);
+
+    int offset = 0;
+
+    for (int i = 0; i < gCurrentLevel->cutsceneCount; ++i) {
+        struct Cutscene* cutscene = &gCurrentLevel->cutscenes[i];
+        float* timeLeft = &gCutsceneStepTimeLeft[offset];
+
+        gCutsceneStepTimeOffset[i] = offset;
+        timeLeft[cutscene->stepCount] = 0.0f;
+
+        for (int step = cutscene->stepCount - 1; step >= 0; --step) {
+            // waiting on another cutscene depends on when it started
+            // so it is only counted once it is the current step
+            float stepTime = cutscene->steps[step].type == CutsceneStepTypeWaitForCutscene ? 0.0f : cutsceneStepEstimateTime(&cutscene->steps[step], NULL);
+            timeLeft[step] = timeLeft[step + 1] + stepTime;
+        }
+
+        offset += cutscene->stepCount + 1;
+    }
+}
+
+float cutsceneRunnerEstimateTimeLeft(struct CutsceneRunner* cutsceneRunner) {
+    if (!cutsceneRunnerIsRunning(cutsceneRunner)) {
+        return 0.0f;
+    }
+
+    int cutsceneIndex = cutsceneRunner->currentCutscene - gCurrentLevel->cutscenes;
+    float* timeLeft = &gCutsceneStepTimeLeft[gCutsceneStepTimeOffset[cutsceneIndex]];
+
+    return cutsceneStepEstimateTime(&cutsceneRunner->currentCutscene->steps[cutsceneRunner->currentStep], &cutsceneRunner->state) +
+        timeLeft[cutsceneRunner->currentStep + 1];
 }
 
 float cutsceneEstimateTimeLeft(struct Cutscene* cutscene) {
@@ -31,6 +31,7 @@ struct CutsceneRunner {
 };
 
 void cutsceneRunnerReset();
+void cutscenesBuildTimeEstimates();
 void cutsceneStart(struct Cutscene* cutscene);
 void cutsceneStop(struct Cutscene* cutscene);
 int cutsceneIsRunning(struct Cutscene* cutscene);
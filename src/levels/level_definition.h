@@ -33,6 +33,12 @@ struct StaticContentElement {
     u8 transformIndex;
 };
 
+struct SignalMaterialSwap {
+    u16 staticIndex;
+    u8 offMaterial;
+    u8 onMaterial;
+};
+
 struct BoundingSphere {
     short x, y, z;
     short radius;
@@ -133,7 +139,8 @@ struct CutsceneStep {
             s16 levelIndex;
         } loadLevel;
         struct {
-            s16 relativeInstructionIndex;
+            // resolved at export so it never points to another goto
+            u16 stepIndex;
         } gotoStep;
         struct {
             u16 cutsceneIndex;
@@ -322,7 +329,7 @@ struct LevelDefinition {
     struct StaticContentElement *staticContent;
     struct StaticIndex* roomBvhList;
     struct Rangeu16 *signalToStaticRanges;
-    u16 *signalToStaticIndices;
+    struct SignalMaterialSwap *signalToStaticSwaps;
     struct Rangeu16 *roomStaticMapping;
     struct PortalSurface* portalSurfaces;
     // maps index of a collisionQuads to indices in portalSurfaces
@@ -349,6 +356,9 @@ struct LevelDefinition {
     struct BallCatcherDefinition* ballCatchers;
     struct ClockDefinition* clocks;
     struct SecurityCameraDefinition* securityCameras;
+    // null terminated list of every pointer in the level that
+    // needs to be adjusted when the level is loaded
+    void*** relocations;
     short collisionQuadCount;
     short staticContentCount;
     short signalToStaticCount;
@@ -12,6 +12,11 @@
 
 #include "../util/rom.h"
 #include "../util/memory.h"
+#include "../util/relocation.h"
+
+#ifdef PORTAL64_WITH_SURFACE_FUZZER
+#include "../scene/portal_surface_fuzzer.h"
+#endif
 
 struct LevelDefinition* gCurrentLevel;
 int gCurrentLevelIndex;
@@ -29,86 +34,203 @@ int levelCount() {
     return LEVEL_COUNT;
 }
 
-#define ADJUST_POINTER_POS(ptr, offset) (void*)((ptr) ? (char*)(ptr) + (offset) : 0)
-
 struct LevelDefinition* levelFixPointers(struct LevelDefinition* from, int pointerOffset) {
     struct LevelDefinition* result = ADJUST_POINTER_POS(from, pointerOffset);
+    result->relocations = ADJUST_POINTER_POS(result->relocations, pointerOffset);
+    relocationApplyAll(result->relocations, pointerOffset);
+    return result;
+}
+
+// small chunks keep the PI free for audio dma between chunks
+#define LEVEL_PREFETCH_CHUNK_SIZE   0x4000
+// the current level keeps running while the next one loads
+// so leave it some room to allocate
+#define LEVEL_PREFETCH_HEAP_RESERVE (64 * 1024)
+// relocation entries applied per frame while prefetching
+#define LEVEL_PREFETCH_RELOCATION_BATCH 512
+
+enum LevelPrefetchState {
+    LevelPrefetchStateIdle,
+    LevelPrefetchStateCopying,
+    LevelPrefetchStateFixingPointers,
+    LevelPrefetchStateReady,
+};
+
+struct LevelPrefetch {
+    enum LevelPrefetchState state;
+    short levelIndex;
+    int relocationIndex;
+    char* memory;
+    int bytesCopied;
+    int chunkSize;
+    struct LevelDefinition* levelDefinition;
+};
+
+struct LevelPrefetch gLevelPrefetch;
 
-    result->collisionQuads = ADJUST_POINTER_POS(result->collisionQuads, pointerOffset);
+OSMesgQueue gLevelPrefetchQueue;
+OSMesg gLevelPrefetchMessages[1];
+OSIoMesg gLevelPrefetchIoMesg;
 
-    for (int i = 0; i < result->collisionQuadCount; ++i) {
-        result->collisionQuads[i].collider = ADJUST_POINTER_POS(result->collisionQuads[i].collider, pointerOffset);
-        result->collisionQuads[i].collider->data = ADJUST_POINTER_POS(result->collisionQuads[i].collider->data, pointerOffset);
-        result->collisionQuads[i].body = ADJUST_POINTER_POS(result->collisionQuads[i].body, pointerOffset);
-        result->collisionQuads[i].data = ADJUST_POINTER_POS(result->collisionQuads[i].data, pointerOffset);
+static int levelPointerOffset(struct LevelMetadata* metadata, char* memory) {
+    return memory - metadata->segmentStart;
+}
+
+static void levelPrefetchStartChunk() {
+    struct LevelMetadata* metadata = &gLevelList[gLevelPrefetch.levelIndex];
+    int remaining = (metadata->segmentRomEnd - metadata->segmentRomStart) - gLevelPrefetch.bytesCopied;
+
+    if (remaining <= 0) {
+        gLevelPrefetch.chunkSize = 0;
+        gLevelPrefetch.state = LevelPrefetchStateFixingPointers;
+        gLevelPrefetch.relocationIndex = 0;
+        int pointerOffset = levelPointerOffset(metadata, gLevelPrefetch.memory);
+        gLevelPrefetch.levelDefinition = ADJUST_POINTER_POS(metadata->levelDefinition, pointerOffset);
+        gLevelPrefetch.levelDefinition->relocations = ADJUST_POINTER_POS(gLevelPrefetch.levelDefinition->relocations, pointerOffset);
+        return;
     }
 
-    result->staticContent = ADJUST_POINTER_POS(result->staticContent, pointerOffset);
-    result->roomStaticMapping = ADJUST_POINTER_POS(result->roomStaticMapping, pointerOffset);
-    result->signalToStaticRanges = ADJUST_POINTER_POS(result->signalToStaticRanges, pointerOffset);
-    result->signalToStaticIndices = ADJUST_POINTER_POS(result->signalToStaticIndices, pointerOffset);
-    result->portalSurfaces = ADJUST_POINTER_POS(result->portalSurfaces, pointerOffset);
+    gLevelPrefetch.chunkSize = remaining < LEVEL_PREFETCH_CHUNK_SIZE ? remaining : LEVEL_PREFETCH_CHUNK_SIZE;
+
+    romCopyAsync(
+        metadata->segmentRomStart + gLevelPrefetch.bytesCopied,
+        gLevelPrefetch.memory + gLevelPrefetch.bytesCopied,
+        gLevelPrefetch.chunkSize,
+        &gLevelPrefetchIoMesg,
+        &gLevelPrefetchQueue
+    );
+}
+
+static int levelPrefetchCheckChunk(int shouldBlock) {
+    OSMesg dummyMesg;
 
-    for (int i = 0; i < result->portalSurfaceCount; ++i) {
-        result->portalSurfaces[i].vertices = ADJUST_POINTER_POS(result->portalSurfaces[i].vertices, pointerOffset);
-        result->portalSurfaces[i].edges = ADJUST_POINTER_POS(result->portalSurfaces[i].edges, pointerOffset);
-        result->portalSurfaces[i].gfxVertices = ADJUST_POINTER_POS(result->portalSurfaces[i].gfxVertices, pointerOffset);
+    if (osRecvMesg(&gLevelPrefetchQueue, &dummyMesg, shouldBlock ? OS_MESG_BLOCK : OS_MESG_NOBLOCK) == -1) {
+        return 0;
     }
 
-    result->portalSurfaceMappingRange = ADJUST_POINTER_POS(result->portalSurfaceMappingRange, pointerOffset);
-    result->portalSurfaceDynamicMappingRange = ADJUST_POINTER_POS(result->portalSurfaceDynamicMappingRange, pointerOffset);
-    result->portalSurfaceMappingIndices = ADJUST_POINTER_POS(result->portalSurfaceMappingIndices, pointerOffset);
-    result->triggers = ADJUST_POINTER_POS(result->triggers, pointerOffset);
+    gLevelPrefetch.bytesCopied += gLevelPrefetch.chunkSize;
+    levelPrefetchStartChunk();
+
+    return 1;
+}
 
-    for (int i = 0; i < result->triggerCount; ++i) {
-        result->triggers[i].triggers = ADJUST_POINTER_POS(result->triggers[i].triggers, pointerOffset);
+static void levelPrefetchStep(int shouldBlock) {
+    switch (gLevelPrefetch.state) {
+        case LevelPrefetchStateCopying:
+            levelPrefetchCheckChunk(shouldBlock);
+            break;
+        case LevelPrefetchStateFixingPointers:
+        {
+            struct LevelMetadata* metadata = &gLevelList[gLevelPrefetch.levelIndex];
+            gLevelPrefetch.relocationIndex = relocationApply(
+                gLevelPrefetch.levelDefinition->relocations, 
+                levelPointerOffset(metadata, gLevelPrefetch.memory), 
+                gLevelPrefetch.relocationIndex,
+                LEVEL_PREFETCH_RELOCATION_BATCH
+            );
+
+            if (gLevelPrefetch.relocationIndex == RELOCATION_DONE) {
+                gLevelPrefetch.state = LevelPrefetchStateReady;
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+static void levelPrefetchFinish() {
+    while (gLevelPrefetch.state != LevelPrefetchStateIdle && gLevelPrefetch.state != LevelPrefetchStateReady) {
+        levelPrefetchStep(1);
     }
-    
-    result->cutscenes = ADJUST_POINTER_POS(result->cutscenes, pointerOffset);
+}
 
-    for (int i = 0; i < result->cutsceneCount; ++i) {
-        result->cutscenes[i].steps = ADJUST_POINTER_POS(result->cutscenes[i].steps, pointerOffset);
+static void levelPrefetchCancel() {
+    // an in flight dma has to land before the memory can be reused
+    if (gLevelPrefetch.state == LevelPrefetchStateCopying) {
+        OSMesg dummyMesg;
+        osRecvMesg(&gLevelPrefetchQueue, &dummyMesg, OS_MESG_BLOCK);
     }
 
-    result->locations = ADJUST_POINTER_POS(result->locations, pointerOffset);
-    result->roomBvhList = ADJUST_POINTER_POS(result->roomBvhList, pointerOffset);
-    result->world.rooms = ADJUST_POINTER_POS(result->world.rooms, pointerOffset);
-    result->world.doorways = ADJUST_POINTER_POS(result->world.doorways, pointerOffset);
+    gLevelPrefetch.state = LevelPrefetchStateIdle;
+}
 
-    for (int i = 0; i < result->world.roomCount; ++i) {
-        result->world.rooms[i].quadIndices = ADJUST_POINTER_POS(result->world.rooms[i].quadIndices, pointerOffset);
-        result->world.rooms[i].cellContents = ADJUST_POINTER_POS(result->world.rooms[i].cellContents, pointerOffset);
-        result->world.rooms[i].doorwayIndices = ADJUST_POINTER_POS(result->world.rooms[i].doorwayIndices, pointerOffset);
+void levelPrefetch(int index) {
+    if (index == NEXT_LEVEL) {
+        index = gCurrentLevelIndex + 1;
+    }
 
-        result->roomBvhList[i].boxIndex = ADJUST_POINTER_POS(result->roomBvhList[i].boxIndex, pointerOffset);
-        result->roomBvhList[i].animatedBoxes = ADJUST_POINTER_POS(result->roomBvhList[i].animatedBoxes, pointerOffset);
+    if (index < 0 || index >= LEVEL_COUNT) {
+        return;
     }
 
-    result->doors = ADJUST_POINTER_POS(result->doors, pointerOffset);
-    result->buttons = ADJUST_POINTER_POS(result->buttons, pointerOffset);
-    result->signalOperators = ADJUST_POINTER_POS(result->signalOperators, pointerOffset);
-    result->decor = ADJUST_POINTER_POS(result->decor, pointerOffset);
-    result->fizzlers = ADJUST_POINTER_POS(result->fizzlers, pointerOffset);
-    result->elevators = ADJUST_POINTER_POS(result->elevators, pointerOffset);
-    result->pedestals = ADJUST_POINTER_POS(result->pedestals, pointerOffset);
-    result->signage = ADJUST_POINTER_POS(result->signage, pointerOffset);
-    result->boxDroppers = ADJUST_POINTER_POS(result->boxDroppers, pointerOffset);
-    result->switches = ADJUST_POINTER_POS(result->switches, pointerOffset);
-    result->dynamicBoxes = ADJUST_POINTER_POS(result->dynamicBoxes, pointerOffset);
-    result->ballLaunchers = ADJUST_POINTER_POS(result->ballLaunchers, pointerOffset);
-    result->ballCatchers = ADJUST_POINTER_POS(result->ballCatchers, pointerOffset);
-    result->clocks = ADJUST_POINTER_POS(result->clocks, pointerOffset);
-    result->securityCameras = ADJUST_POINTER_POS(result->securityCameras, pointerOffset);
-
-    result->animations = ADJUST_POINTER_POS(result->animations, pointerOffset);
-
-    for (int i = 0; i < result->animationInfoCount; ++i) {
-        result->animations[i].clips = ADJUST_POINTER_POS(result->animations[i].clips, pointerOffset);
-        result->animations[i].armature.boneParentIndex = ADJUST_POINTER_POS(result->animations[i].armature.boneParentIndex, pointerOffset);
-        result->animations[i].armature.pose = ADJUST_POINTER_POS(result->animations[i].armature.pose, pointerOffset);
+    if (gLevelPrefetch.state != LevelPrefetchStateIdle) {
+        if (gLevelPrefetch.levelIndex == index) {
+            return;
+        }
+
+        levelPrefetchCancel();
+        free(gLevelPrefetch.memory);
     }
 
-    return result;
+    osCreateMesgQueue(&gLevelPrefetchQueue, gLevelPrefetchMessages, 1);
+
+    struct LevelMetadata* metadata = &gLevelList[index];
+    int segmentSize = metadata->segmentRomEnd - metadata->segmentRomStart;
+
+    if (calculateLargestFreeChunk() < segmentSize + LEVEL_PREFETCH_HEAP_RESERVE) {
+        // not enough room while the current level is loaded
+        // levelLoad will fall back to a blocking load
+        return;
+    }
+
+    gLevelPrefetch.memory = malloc(segmentSize);
+
+    gLevelPrefetch.state = LevelPrefetchStateCopying;
+    gLevelPrefetch.levelIndex = index;
+    gLevelPrefetch.bytesCopied = 0;
+    levelPrefetchStartChunk();
+}
+
+void levelPrefetchUpdate() {
+    levelPrefetchStep(0);
+}
+
+void* levelPrefetchRetain(int index) {
+    if (gLevelPrefetch.state == LevelPrefetchStateIdle) {
+        return NULL;
+    }
+
+    if (gLevelPrefetch.levelIndex != index) {
+        // the heap is about to be reset so there is no need to free the memory
+        levelPrefetchCancel();
+        return NULL;
+    }
+
+    // the pointers have to be fixed before the heap reset moves the level
+    levelPrefetchFinish();
+
+    return gLevelPrefetch.memory;
+}
+
+// the heap reset moves the retained level to the end of the heap
+void levelPrefetchMoved(void* memory) {
+    if (!memory || gLevelPrefetch.state == LevelPrefetchStateIdle) {
+        return;
+    }
+
+    int delta = (char*)memory - gLevelPrefetch.memory;
+
+    if (!delta) {
+        return;
+    }
+
+    struct LevelMetadata* metadata = &gLevelList[gLevelPrefetch.levelIndex];
+
+    gLevelPrefetch.memory = memory;
+    gLevelPrefetch.levelDefinition = ADJUST_POINTER_POS(gLevelPrefetch.levelDefinition, delta);
+    gLevelPrefetch.levelDefinition->relocations = ADJUST_POINTER_POS(gLevelPrefetch.levelDefinition->relocations, delta);
+    relocationShift(gLevelPrefetch.levelDefinition->relocations, levelPointerOffset(metadata, memory), delta);
 }
 
 void levelLoad(int index) {
@@ -118,16 +240,32 @@ void levelLoad(int index) {
 
     struct LevelMetadata* metadata = &gLevelList[index];
 
-    void* memory = malloc(metadata->segmentRomEnd - metadata->segmentRomStart);
-    romCopy(metadata->segmentRomStart, memory, metadata->segmentRomEnd - metadata->segmentRomStart);
+    if (gLevelPrefetch.state != LevelPrefetchStateIdle && gLevelPrefetch.levelIndex == index) {
+        levelPrefetchFinish();
+
+        gLevelSegment = gLevelPrefetch.memory;
+        gCurrentLevel = gLevelPrefetch.levelDefinition;
+        gLevelPrefetch.state = LevelPrefetchStateIdle;
+    } else {
+        levelPrefetchCancel();
+
+        void* memory = malloc(metadata->segmentRomEnd - metadata->segmentRomStart);
+        romCopy(metadata->segmentRomStart, memory, metadata->segmentRomEnd - metadata->segmentRomStart);
+
+        gLevelSegment = memory;
 
-    gLevelSegment = memory;
+        gCurrentLevel = levelFixPointers(metadata->levelDefinition, levelPointerOffset(metadata, memory));
+    }
 
-    gCurrentLevel = levelFixPointers(metadata->levelDefinition, (char*)memory - metadata->segmentStart);
     gCurrentLevelIndex = index;
 
     collisionSceneInit(&gCollisionScene, gCurrentLevel->collisionQuads, gCurrentLevel->collisionQuadCount, &gCurrentLevel->world);
+    cutscenesBuildTimeEstimates();
     soundPlayerResume();
+
+#ifdef PORTAL64_WITH_SURFACE_FUZZER
+    portalSurfaceFuzzLevel(PORTAL_SURFACE_FUZZ_POKES);
+#endif
 }
 
 void levelClearQueuedLevel() {
@@ -156,6 +294,7 @@ void levelQueueLoad(int index, struct Transform* relativeExitTransform, struct V
         gRelativeVelocity = gZeroVec;
     }
     checkpointClear();
+    levelPrefetch(gQueuedLevel);
 }
 
 void levelLoadLastCheckpoint() {
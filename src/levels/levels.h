@@ -13,6 +13,13 @@
 int levelCount();
 void levelLoad(int index);
 
+// starts loading a level in the background so levelLoad doesn't have to block
+void levelPrefetch(int index);
+void levelPrefetchUpdate();
+// returns the memory of the prefetched level so it can survive a heap reset
+void* levelPrefetchRetain(int index);
+void levelPrefetchMoved(void* memory);
+
 void levelQueueLoad(int index, struct Transform* relativeExitTransform, struct Vector3* relativeVelocity);
 void levelLoadLastCheckpoint();
 int levelGetQueued();
@@ -145,31 +145,35 @@ void staticRender(struct Transform* cameraTransform, struct FrustrumCullingInfor
     renderSceneFree(renderScene);
 }
 
-u8 gSignalMaterialMapping[] = {
-    INDICATOR_LIGHTS_INDEX, INDICATOR_LIGHTS_ON_INDEX,
-    SIGNAGE_DOORSTATE_INDEX, SIGNAGE_DOORSTATE_ON_INDEX,
-};
+void staticRenderApplySignalMaterials(int signal, int isOn) {
+    struct Rangeu16* range = &gCurrentLevel->signalToStaticRanges[signal];
 
-void staticRenderCheckSignalMaterials() {
-    for (int signal = 0; signal < gCurrentLevel->signalToStaticCount; ++signal) {
-        int currentSignal = signalsRead(signal);
+    for (int index = range->min; index < range->max; ++index) {
+        struct SignalMaterialSwap* swap = &gCurrentLevel->signalToStaticSwaps[index];
+        gCurrentLevel->staticContent[swap->staticIndex].materialIndex = isOn ? swap->onMaterial : swap->offMaterial;
+    }
+}
 
-        if (currentSignal != signalsReadPrevious(signal)) {
-            struct Rangeu16* range = &gCurrentLevel->signalToStaticRanges[signal];
+void staticRenderCheckSignalMaterials() {
+    int binCount = SIGNAL_BIN_COUNT(gCurrentLevel->signalToStaticCount);
 
-            int toIndex = currentSignal ? 1 : 0;
-            int fromIndex = currentSignal ? 0 : 1;
+    for (int bin = 0; bin < binCount; ++bin) {
+        unsigned long long changed = signalsChangedMask(bin);
+        int signal = bin << 6;
 
-            for (int index = range->min; index < range->max; ++index) {
-                struct StaticContentElement* element = &gCurrentLevel->staticContent[gCurrentLevel->signalToStaticIndices[index]];
+        while (changed) {
+            // skip unchanged signals a byte at a time
+            while (!(changed & 0xFF)) {
+                changed >>= 8;
+                signal += 8;
+            }
 
-                for (int materialIndex = 0; materialIndex < sizeof(gSignalMaterialMapping) / sizeof(*gSignalMaterialMapping); materialIndex += 2) {
-                    if (element->materialIndex == gSignalMaterialMapping[materialIndex + fromIndex]) {
-                        element->materialIndex = gSignalMaterialMapping[materialIndex + toIndex];
-                        break;
-                    }
-                }
+            if ((changed & 1) && signal < gCurrentLevel->signalToStaticCount) {
+                staticRenderApplySignalMaterials(signal, signalsRead(signal));
             }
+
+            changed >>= 1;
+            ++signal;
         }
     }
 }
\ No newline at end of file
@@ -275,6 +275,8 @@ static void gameProc(void* arg) {
                     break;
                 }
 
+                levelPrefetchUpdate();
+
                 if (levelGetQueued() != NO_QUEUED_LEVEL) {
                     if (pendingGFX == 0) {
                         soundPlayerStopAll();
@@ -283,7 +285,7 @@ static void gameProc(void* arg) {
                         portalSurfaceRevert(1);
                         portalSurfaceRevert(0);
                         portalSurfaceCleanupQueueInit();
-                        heapInit(_heapStart, memoryEnd);
+                        levelPrefetchMoved(heapInitPreserving(_heapStart, memoryEnd, levelPrefetchRetain(levelGetQueued())));
                         profileClearAddressMap();
                         translationsLoad(gSaveData.controls.subtitleLanguage);
                         levelLoadWithCallbacks(levelGetQueued());
@@ -346,6 +348,7 @@ static void gameProc(void* arg) {
 
             case (OS_SC_DONE_MSG):
                 --pendingGFX;
+                graphicsTaskFinished(msg);
                 portalSurfaceCheckCleanupQueue();
                 menuTickDeferredQueue();
 
@@ -500,8 +500,7 @@ void controlsRenderPrompt(enum ControllerAction action, char* message, float opa
     if (message == NULL || (message != NULL && message[0] == '\0'))
         return;
     
-    struct FontRenderer* fontRender = stackMalloc(sizeof(struct FontRenderer));
-    fontRendererLayout(fontRender, &gDejaVuSansFont, message, SCREEN_WD - (CONTROL_PROMPT_RIGHT_MARGIN + (CONTROL_PROMPT_PADDING * 2)));
+    struct FontRenderer* fontRender = fontRendererLayoutCached(&gDejaVuSansFont, message, SCREEN_WD - (CONTROL_PROMPT_RIGHT_MARGIN + (CONTROL_PROMPT_PADDING * 2)));
     
     int iconsWidth = controlsMeasureIcons(action);
 
@@ -542,16 +541,13 @@ void controlsRenderPrompt(enum ControllerAction action, char* message, float opa
     gDPSetEnvColor(renderState->dl++, 232, 206, 80, opacityAsInt);
     renderState->dl = controlsRenderActionIcons(renderState->dl, action, textPositionX - CONTROL_PROMPT_PADDING, textPositionY);
     gSPDisplayList(renderState->dl++, ui_material_revert_list[BUTTON_ICONS_INDEX]);
-    
-    stackMallocFree(fontRender);
 }
 
 void controlsRenderSubtitle(char* message, float textOpacity, float backgroundOpacity, struct RenderState* renderState, enum SubtitleType subtitleType) {
     if (message == NULL || (message != NULL && message[0] == '\0'))
         return;
     
-    struct FontRenderer* fontRender = stackMalloc(sizeof(struct FontRenderer));
-    fontRendererLayout(fontRender, &gDejaVuSansFont, message, SCREEN_WD - (SUBTITLE_SIDE_MARGIN + SUBTITLE_PADDING) * 2);
+    struct FontRenderer* fontRender = fontRendererLayoutCached(&gDejaVuSansFont, message, SCREEN_WD - (SUBTITLE_SIDE_MARGIN + SUBTITLE_PADDING) * 2);
 
     int textOpacityAsInt = (int)(255 * textOpacity);
 
@@ -598,6 +594,4 @@ void controlsRenderSubtitle(char* message, float textOpacity, float backgroundOp
     renderState->dl = fontRendererBuildGfx(fontRender, gDejaVuSansImages, textPositionX, textPositionY, &textColor, renderState->dl);
 
     gSPDisplayList(renderState->dl++, ui_material_revert_list[DEJAVU_SANS_0_INDEX]);
-
-    stackMallocFree(fontRender);
 }
@@ -24,7 +24,7 @@ void loadGamePopulate(struct LoadGameMenu* loadGame) {
         savefileInfo[i].slotIndex = saveSlots[i].saveSlot;
         savefileInfo[i].testchamberDisplayNumber = saveSlots[i].testChamber;
         savefileInfo[i].savefileName = saveSlots[i].saveSlot == 0 ? translationsGet(GAMEUI_AUTOSAVE) : NULL;
-        savefileInfo[i].screenshot = (u16*)SCREEN_SHOT_SRAM(saveSlots[i].saveSlot);
+        savefileInfo[i].screenshot = (ThumbnailPixel*)SCREEN_SHOT_SRAM(saveSlots[i].saveSlot);
         savefileInfo[i].isFree = 0;
     }
 
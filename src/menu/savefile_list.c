@@ -337,6 +337,11 @@ void savefileListRender(struct SavefileListMenu* savefileList, struct RenderStat
 
     gSPDisplayList(renderState->dl++, ui_material_list[IMAGE_COPY_INDEX]);
 
+#if SAVEFILE_CI8_THUMBNAILS
+    gDPSetTextureLUT(renderState->dl++, G_TT_RGBA16);
+    gDPLoadTLUT_pal256(renderState->dl++, gThumbnailPalette);
+#endif
+
     for (int i = 0; i < MAX_VISIBLE_SLOTS; ++i) {
         struct SavefileListSlot* slot = &savefileList->slots[i];
 
@@ -344,6 +349,20 @@ void savefileListRender(struct SavefileListMenu* savefileList, struct RenderStat
             continue;
         }
 
+#if SAVEFILE_CI8_THUMBNAILS
+        gDPLoadTextureTile(
+            renderState->dl++,
+            K0_TO_PHYS(slot->imageData),
+            G_IM_FMT_CI, G_IM_SIZ_8b,
+            SAVE_SLOT_IMAGE_W, SAVE_SLOT_IMAGE_H,
+            0, 0,
+            SAVE_SLOT_IMAGE_W-1, SAVE_SLOT_IMAGE_H-1,
+            0,
+            G_TX_CLAMP, G_TX_CLAMP,
+            G_TX_NOMASK, G_TX_NOMASK,
+            G_TX_NOLOD, G_TX_NOLOD
+        );
+#else
         gDPLoadTextureTile(
             renderState->dl++,
             K0_TO_PHYS(slot->imageData),
@@ -356,6 +375,7 @@ void savefileListRender(struct SavefileListMenu* savefileList, struct RenderStat
             G_TX_NOMASK, G_TX_NOMASK,
             G_TX_NOLOD, G_TX_NOLOD
         );
+#endif
         
         gSPTextureRectangle(
             renderState->dl++,
@@ -368,6 +388,10 @@ void savefileListRender(struct SavefileListMenu* savefileList, struct RenderStat
         );
     }
 
+#if SAVEFILE_CI8_THUMBNAILS
+    gDPSetTextureLUT(renderState->dl++, G_TT_NONE);
+#endif
+
     gSPDisplayList(renderState->dl++, ui_material_revert_list[IMAGE_COPY_INDEX]);
 
     if (savefileList->confirmationDialog.isShown) {
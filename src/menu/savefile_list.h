@@ -12,7 +12,7 @@ struct SavefileInfo {
     short slotIndex;
     short testchamberDisplayNumber;
     char* savefileName;
-    u16* screenshot;
+    ThumbnailPixel* screenshot;
     int isFree;
 };
 
@@ -2,6 +2,7 @@
 
 #include "../util/memory.h"
 #include "../util/rom.h"
+#include "../font/font.h"
 
 #include "../build/src/audio/subtitles.h"
 
@@ -43,6 +44,8 @@ void translationsReload(int language) {
     }
 
     free(gLoadedLanugageBlock);
+    // the new strings could land at the same addresses
+    fontRendererClearLayoutCache();
     translationsLoad(language);
 }
 
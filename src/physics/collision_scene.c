@@ -274,7 +274,7 @@ void collisionScenePushObjectsOutOfPortal(int portalIndex) {
     }
 }
 
-void collisionSceneRaycastRoom(struct CollisionScene* scene, struct Room* room, struct Ray* ray, int collisionLayers, struct RaycastHit* hit) {
+void collisionSceneRaycastRoom(struct CollisionScene* scene, struct Room* room, struct Ray* ray, int collisionLayers, int ignoreLayers, struct RaycastHit* hit) {
     int currX = GRID_CELL_X(room, ray->origin.x);
     int currZ = GRID_CELL_Z(room, ray->origin.z);
 
@@ -322,7 +322,7 @@ void collisionSceneRaycastRoom(struct CollisionScene* scene, struct Room* room,
 
             struct CollisionObject* collisionObject = &scene->quads[room->quadIndices[i]];
 
-            if ((collisionObject->collisionLayers & collisionLayers) == 0) {
+            if ((collisionObject->collisionLayers & collisionLayers) == 0 || (collisionObject->collisionLayers & ignoreLayers) != 0) {
                 continue;
             }
 
@@ -433,7 +433,7 @@ int collisionSceneRaycast(struct CollisionScene* scene, int roomIndex, struct Ra
 
     while (roomsToCheck && roomIndex != -1) {
         struct Room* room = &scene->world->rooms[roomIndex];
-        collisionSceneRaycastRoom(scene, room, ray, collisionLayers, hit);
+        collisionSceneRaycastRoom(scene, room, ray, collisionLayers, 0, hit);
 
         if (hit->distance != maxDistance) {
             hit->roomIndex = roomIndex;
@@ -493,6 +493,42 @@ int collisionSceneRaycast(struct CollisionScene* scene, int roomIndex, struct Ra
     return hit->distance != maxDistance;
 }
 
+struct CollisionObject* collisionSceneFindOccluder(struct CollisionScene* scene, int roomIndex, struct Vector3* from, struct Vector3* to) {
+    struct Ray ray;
+    ray.origin = *from;
+    vector3Sub(to, from, &ray.dir);
+
+    float maxDistance = sqrtf(vector3MagSqrd(&ray.dir));
+
+    if (maxDistance < 0.00001f) {
+        return NULL;
+    }
+
+    vector3Scale(&ray.dir, &ray.dir, 1.0f / maxDistance);
+
+    struct RaycastHit hit;
+    hit.distance = maxDistance;
+
+    int roomsToCheck = 5;
+
+    while (roomsToCheck && roomIndex != -1) {
+        struct Room* room = &scene->world->rooms[roomIndex];
+        // colliders with any extra layer such as transparent never occlude
+        collisionSceneRaycastRoom(scene, room, &ray, COLLISION_LAYERS_STATIC, ~COLLISION_LAYERS_OCCLUDER, &hit);
+
+        if (hit.distance != maxDistance) {
+            // colliders that are missing a default layer are usually clip
+            // brushes with nothing drawn so they don't count either
+            return (hit.object->collisionLayers & COLLISION_LAYERS_OCCLUDER) == COLLISION_LAYERS_OCCLUDER ? hit.object : NULL;
+        }
+
+        roomIndex = collisionSceneRaycastDoorways(scene, room, &ray, maxDistance, roomIndex);
+        --roomsToCheck;
+    }
+
+    return NULL;
+}
+
 void collisionSceneGetPortalTransform(int fromPortal, struct Transform* out) {
     struct Transform inverseA;
     transformInvert(gCollisionScene.portalTransforms[fromPortal], &inverseA);
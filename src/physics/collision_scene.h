@@ -46,6 +46,11 @@ void collisionScenePushObjectsOutOfPortal(int portalIndex);
 
 int collisionSceneRaycast(struct CollisionScene* scene, int roomIndex, struct Ray* ray, int collisionLayers, float maxDistance, int passThroughPortals, struct RaycastHit* hit);
 int collisionSceneRaycastOnlyDynamic(struct CollisionScene* scene, struct Ray* ray, int collisionLayers, float maxDistance, struct RaycastHit* hit);
+// the layers the level exporter gives an opaque static collider by default
+#define COLLISION_LAYERS_OCCLUDER   (COLLISION_LAYERS_STATIC | COLLISION_LAYERS_TANGIBLE | COLLISION_LAYERS_BLOCK_BALL)
+
+// returns the opaque static quad blocking the line between from and to or NULL
+struct CollisionObject* collisionSceneFindOccluder(struct CollisionScene* scene, int roomIndex, struct Vector3* from, struct Vector3* to);
 
 void collisionSceneGetPortalTransform(int fromPortal, struct Transform* out);
 
@@ -2,6 +2,7 @@
 #include "savefile.h"
 #include "util/memory.h"
 #include "controls/controller.h"
+#include "defs.h"
 
 #include "../controls/controller_actions.h"
 #include "../build/src/audio/subtitles.h"
@@ -30,32 +31,143 @@ extern OSMesgQueue dmaMessageQ;
 
 #define SRAM_ADDR   0x08000000
 
-void savefileSramSave(void* dst, void* src, int size) {
+// writes are split up so other PI transfers such as
+// audio and level streaming aren't stuck behind them
+#define SRAM_WRITE_CHUNK_SIZE   0x200
+
+#define SAVE_JOB_COUNT          4
+#define SAVE_STACK_SIZE_BYTES   1024
+
+struct SaveJob {
+    void* sramAddr;
+    void* src;
+    int size;
+};
+
+// the save thread writes from these copies so the
+// game can keep changing the originals
+struct SaveData __attribute__((aligned(8))) gSaveDataSnapshot;
+char __attribute__((aligned(8))) gCheckpointSnapshot[MAX_CHECKPOINT_SIZE];
+ThumbnailPixel __attribute__((aligned(8))) gScreenshotSnapshot[SAVE_SLOT_IMAGE_W * SAVE_SLOT_IMAGE_H];
+
+static struct SaveJob gSaveJobs[SAVE_JOB_COUNT];
+static int gNextSaveJob;
+static volatile int gPendingSaveJobs;
+// which snapshots are waiting to be written
+static volatile int gSaveDataSnapshotBusy;
+static volatile int gCheckpointSnapshotBusy;
+
+static OSThread gSaveThread;
+static u64 gSaveThreadStack[SAVE_STACK_SIZE_BYTES/sizeof(u64)];
+
+static OSMesgQueue gSaveJobQueue;
+static OSMesg gSaveJobMessages[SAVE_JOB_COUNT];
+static OSMesgQueue gSaveDoneQueue;
+static OSMesg gSaveDoneMessages[SAVE_JOB_COUNT];
+static OSMesgQueue gSaveDmaQueue;
+static OSMesg gSaveDmaMessage;
+static OSMesgQueue gSaveTimerQueue;
+static OSMesg gSaveTimerMessage;
+
+static void savefileSramWrite(void* dst, void* src, int size) {
     OSTimer timer;
 
     OSIoMesg dmaIoMesgBuf;
 
-    // save checkpoint
-    dmaIoMesgBuf.hdr.pri = OS_MESG_PRI_HIGH;
-    dmaIoMesgBuf.hdr.retQueue = &dmaMessageQ;
-    dmaIoMesgBuf.dramAddr = src;
-    dmaIoMesgBuf.devAddr = (u32)dst;
-    dmaIoMesgBuf.size = size;
-
     osWritebackDCache(src, size);
-    if (osEPiStartDma(&gSramHandle, &dmaIoMesgBuf, OS_WRITE) == -1)
-    {
-        return;
+
+    while (size > 0) {
+        int chunkSize = size < SRAM_WRITE_CHUNK_SIZE ? size : SRAM_WRITE_CHUNK_SIZE;
+
+        dmaIoMesgBuf.hdr.pri = OS_MESG_PRI_NORMAL;
+        dmaIoMesgBuf.hdr.retQueue = &gSaveDmaQueue;
+        dmaIoMesgBuf.dramAddr = src;
+        dmaIoMesgBuf.devAddr = (u32)dst;
+        dmaIoMesgBuf.size = chunkSize;
+
+        if (osEPiStartDma(&gSramHandle, &dmaIoMesgBuf, OS_WRITE) == -1)
+        {
+            return;
+        }
+        (void) osRecvMesg(&gSaveDmaQueue, NULL, OS_MESG_BLOCK);
+
+        src = (char*)src + chunkSize;
+        dst = (char*)dst + chunkSize;
+        size -= chunkSize;
     }
-    (void) osRecvMesg(&dmaMessageQ, NULL, OS_MESG_BLOCK);
 
-    osSetTimer(&timer, SRAM_CHUNK_DELAY, 0, &timerQueue, 0);
-    (void) osRecvMesg(&timerQueue, NULL, OS_MESG_BLOCK);
+    osSetTimer(&timer, SRAM_CHUNK_DELAY, 0, &gSaveTimerQueue, 0);
+    (void) osRecvMesg(&gSaveTimerQueue, NULL, OS_MESG_BLOCK);
+}
+
+static void savefileInitThumbnailTables();
+
+static void savefileThreadLoop(void* arg) {
+    for (;;) {
+        struct SaveJob* job;
+        (void) osRecvMesg(&gSaveJobQueue, (OSMesg*)&job, OS_MESG_BLOCK);
+
+        savefileSramWrite(job->sramAddr, job->src, job->size);
+
+        OSIntMask saveMask = osGetIntMask();
+        osSetIntMask(OS_IM_NONE);
+        if (job->src == &gSaveDataSnapshot) {
+            gSaveDataSnapshotBusy = 0;
+        } else if (job->src == gCheckpointSnapshot) {
+            gCheckpointSnapshotBusy = 0;
+        }
+        --gPendingSaveJobs;
+        osSetIntMask(saveMask);
+
+        (void) osSendMesg(&gSaveDoneQueue, NULL, OS_MESG_NOBLOCK);
+    }
+}
+
+int savefileIsSaving() {
+    return gPendingSaveJobs != 0;
+}
+
+void savefileWaitForSave() {
+    while (gPendingSaveJobs) {
+        (void) osRecvMesg(&gSaveDoneQueue, NULL, OS_MESG_BLOCK);
+    }
+}
+
+// snapshots are only reused once the save thread is done with them
+static void savefileWaitForSnapshot(volatile int* busy) {
+    while (*busy) {
+        (void) osRecvMesg(&gSaveDoneQueue, NULL, OS_MESG_BLOCK);
+    }
+}
+
+static void savefileQueueWrite(void* dst, void* src, int size) {
+    // done messages from earlier jobs may still be queued so
+    // keep waiting until a slot is actually free
+    while (gPendingSaveJobs == SAVE_JOB_COUNT) {
+        (void) osRecvMesg(&gSaveDoneQueue, NULL, OS_MESG_BLOCK);
+    }
+
+    struct SaveJob* job = &gSaveJobs[gNextSaveJob];
+    gNextSaveJob = (gNextSaveJob + 1) % SAVE_JOB_COUNT;
+
+    job->sramAddr = dst;
+    job->src = src;
+    job->size = size;
+
+    OSIntMask saveMask = osGetIntMask();
+    osSetIntMask(OS_IM_NONE);
+    ++gPendingSaveJobs;
+    osSetIntMask(saveMask);
+
+    (void) osSendMesg(&gSaveJobQueue, job, OS_MESG_BLOCK);
 }
 
 int savefileSramLoad(void* sramAddr, void* ramAddr, int size) {
     OSTimer timer;
 
+    // make sure any queued writes land first
+    savefileWaitForSave();
+
     OSIoMesg dmaIoMesgBuf;
 
     dmaIoMesgBuf.hdr.pri = OS_MESG_PRI_HIGH;
@@ -135,6 +247,22 @@ void savefileLoad() {
     __osPiTable = &gSramHandle;
     osSetIntMask(saveMask);
 
+    osCreateMesgQueue(&gSaveJobQueue, gSaveJobMessages, SAVE_JOB_COUNT);
+    osCreateMesgQueue(&gSaveDoneQueue, gSaveDoneMessages, SAVE_JOB_COUNT);
+    osCreateMesgQueue(&gSaveDmaQueue, &gSaveDmaMessage, 1);
+    osCreateMesgQueue(&gSaveTimerQueue, &gSaveTimerMessage, 1);
+
+    osCreateThread(
+        &gSaveThread, 
+        7, 
+        savefileThreadLoop, 
+        0, 
+        gSaveThreadStack + (SAVE_STACK_SIZE_BYTES/sizeof(u64)),
+        (OSPri)SAVE_PRIORITY
+    );
+
+    osStartThread(&gSaveThread);
+
     if (!savefileSramLoad((void*)SRAM_ADDR, &gSaveData, sizeof(gSaveData))) {
         savefileNew();
     }
@@ -144,10 +272,16 @@ void savefileLoad() {
     }
 
     controllerSetDeadzone(gSaveData.controls.deadzone * (1.0f / 0xFFFF) * MAX_DEADZONE);
+
+    // the palette is needed to show saved thumbnails before one is grabbed
+    savefileInitThumbnailTables();
 }
 
 void savefileSave() {
-    savefileSramSave((void*)SRAM_ADDR, &gSaveData, sizeof(gSaveData));
+    savefileWaitForSnapshot(&gSaveDataSnapshotBusy);
+    memCopy(&gSaveDataSnapshot, &gSaveData, sizeof(gSaveData));
+    gSaveDataSnapshotBusy = 1;
+    savefileQueueWrite((void*)SRAM_ADDR, &gSaveDataSnapshot, sizeof(gSaveData));
 }
 
 void savefileDeleteGame(int slotIndex) {
@@ -171,9 +305,15 @@ void savefileDeleteGame(int slotIndex) {
 
 #define SAVE_SLOT_SRAM_ADDRESS(index) (SRAM_ADDR + (1 + (index)) * SAVE_SLOT_SIZE)
 
-void savefileSaveGame(Checkpoint checkpoint, u16* screenshot, int testChamberDisplayNumber, int subjectNumber, int slotIndex) {
-    savefileSramSave((void*)SAVE_SLOT_SRAM_ADDRESS(slotIndex), checkpoint, MAX_CHECKPOINT_SIZE);
-    savefileSramSave((void*)SCREEN_SHOT_SRAM(slotIndex), screenshot, THUMBNAIL_IMAGE_SIZE);
+void savefileSaveGame(Checkpoint checkpoint, ThumbnailPixel* screenshot, int testChamberDisplayNumber, int subjectNumber, int slotIndex) {
+    savefileWaitForSnapshot(&gCheckpointSnapshotBusy);
+    memCopy(gCheckpointSnapshot, checkpoint, MAX_CHECKPOINT_SIZE);
+    memCopy(gScreenshotSnapshot, screenshot, THUMBNAIL_IMAGE_SIZE);
+    gCheckpointSnapshotBusy = 1;
+    // the screenshot is queued first so the checkpoint job finishing
+    // means both snapshots are free again
+    savefileQueueWrite((void*)SCREEN_SHOT_SRAM(slotIndex), gScreenshotSnapshot, THUMBNAIL_IMAGE_SIZE);
+    savefileQueueWrite((void*)SAVE_SLOT_SRAM_ADDRESS(slotIndex), gCheckpointSnapshot, MAX_CHECKPOINT_SIZE);
 
     unsigned char prevSortOrder = gSaveData.saveSlotMetadata[slotIndex].saveSlotOrder;
 
@@ -331,7 +471,7 @@ void savefileLoadGame(int slot, Checkpoint checkpoint, int* testChamberIndex, in
     *subjectNumber = gSaveData.saveSlotMetadata[slot].testSubjectNumber;
 }
 
-void savefileLoadScreenshot(u16* target, u16* location) {
+void savefileLoadScreenshot(ThumbnailPixel* target, ThumbnailPixel* location) {
     if ((int)location >= SRAM_START_ADDR && (int)location <= (SRAM_START_ADDR + SRAM_SIZE)) {
         savefileSramLoad(location, target, THUMBNAIL_IMAGE_SIZE);
     } else {
@@ -340,21 +480,90 @@ void savefileLoadScreenshot(u16* target, u16* location) {
 }
 
 
-u16 gScreenGrabBuffer[SAVE_SLOT_IMAGE_W * SAVE_SLOT_IMAGE_H];
+ThumbnailPixel __attribute__((aligned(8))) gScreenGrabBuffer[SAVE_SLOT_IMAGE_W * SAVE_SLOT_IMAGE_H];
+
+// each thumbnail pixel averages a 4x4 grid of samples from its area of the screen
+#define THUMBNAIL_SAMPLES   4
+
+static short gThumbnailColumns[SAVE_SLOT_IMAGE_W * THUMBNAIL_SAMPLES];
+static int gThumbnailRows[SAVE_SLOT_IMAGE_H * THUMBNAIL_SAMPLES];
+static char gThumbnailTablesReady;
+
+#if SAVEFILE_CI8_THUMBNAILS
+u16 __attribute__((aligned(8))) gThumbnailPalette[256];
+#endif
+
+static void savefileInitThumbnailTables() {
+    for (int x = 0; x < SAVE_SLOT_IMAGE_W * THUMBNAIL_SAMPLES; ++x) {
+        gThumbnailColumns[x] = (x * 2 + 1) * SCREEN_WD / (SAVE_SLOT_IMAGE_W * THUMBNAIL_SAMPLES * 2);
+    }
+
+    for (int y = 0; y < SAVE_SLOT_IMAGE_H * THUMBNAIL_SAMPLES; ++y) {
+        gThumbnailRows[y] = ((y * 2 + 1) * SCREEN_HT / (SAVE_SLOT_IMAGE_H * THUMBNAIL_SAMPLES * 2)) * SCREEN_WD;
+    }
+
+#if SAVEFILE_CI8_THUMBNAILS
+    // 3 bits red, 3 bits green, 2 bits blue
+    for (int i = 0; i < 256; ++i) {
+        int r = i >> 5;
+        int g = (i >> 2) & 0x7;
+        int b = i & 0x3;
+
+        r = (r << 2) | (r >> 1);
+        g = (g << 2) | (g >> 1);
+        b = (b << 3) | (b << 1) | (b >> 1);
+
+        gThumbnailPalette[i] = (r << 11) | (g << 6) | (b << 1) | 1;
+    }
+
+    // the rdp loads the palette straight from memory
+    osWritebackDCache(gThumbnailPalette, sizeof(gThumbnailPalette));
+#endif
+
+    gThumbnailTablesReady = 1;
+}
+
+// red and blue are summed in one word and green in another
+// so all three channels are added at once without overflowing
+#define THUMBNAIL_RB_MASK   0xF83E
+#define THUMBNAIL_G_MASK    0x07C0
 
-#define IMAGE_SCALE_FACTOR      (int)((SCREEN_WD << 16) / SAVE_SLOT_IMAGE_W)
-#define SCALE_TO_SOURCE(value)  ((IMAGE_SCALE_FACTOR * (value)) >> 16)
+#define THUMBNAIL_ADD_SAMPLE(row, column) { u16 pixel = (row)[column]; rb += pixel & THUMBNAIL_RB_MASK; g += pixel & THUMBNAIL_G_MASK; }
 
 void savefileGrabScreenshot() {
     u16* cfb = osViGetCurrentFramebuffer();
-    u16* dst = gScreenGrabBuffer;
+    ThumbnailPixel* dst = gScreenGrabBuffer;
+
+    if (!gThumbnailTablesReady) {
+        savefileInitThumbnailTables();
+    }
 
     for (int y = 0; y < SAVE_SLOT_IMAGE_H; ++y) {
+        int* rows = &gThumbnailRows[y * THUMBNAIL_SAMPLES];
+
         for (int x = 0; x < SAVE_SLOT_IMAGE_W; ++x) {
-            int srcX = SCALE_TO_SOURCE(x);
-            int srcY = SCALE_TO_SOURCE(y);
+            short* columns = &gThumbnailColumns[x * THUMBNAIL_SAMPLES];
+            unsigned rb = 0;
+            unsigned g = 0;
+
+            for (int sampleY = 0; sampleY < THUMBNAIL_SAMPLES; ++sampleY) {
+                u16* row = cfb + rows[sampleY];
+                THUMBNAIL_ADD_SAMPLE(row, columns[0]);
+                THUMBNAIL_ADD_SAMPLE(row, columns[1]);
+                THUMBNAIL_ADD_SAMPLE(row, columns[2]);
+                THUMBNAIL_ADD_SAMPLE(row, columns[3]);
+            }
+
+            // 16 samples
+            unsigned r5 = (rb >> 15) & 0x1F;
+            unsigned g5 = (g >> 10) & 0x1F;
+            unsigned b5 = (rb >> 5) & 0x1F;
 
-            *dst = cfb[srcX + srcY * SCREEN_WD];
+#if SAVEFILE_CI8_THUMBNAILS
+            *dst = ((r5 >> 2) << 5) | ((g5 >> 2) << 2) | (b5 >> 3);
+#else
+            *dst = (r5 << 11) | (g5 << 6) | (b5 << 1) | 1;
+#endif
 
             ++dst;
         }
@@ -12,15 +12,31 @@
 #define SAVE_SLOT_IMAGE_W   36
 #define SAVE_SLOT_IMAGE_H   27
 
-#define THUMBNAIL_IMAGE_SIZE    (SAVE_SLOT_IMAGE_W * SAVE_SLOT_IMAGE_H * sizeof(u16))
+// 8 bit thumbnails use a fixed palette and take half the sram
+#ifndef SAVEFILE_CI8_THUMBNAILS
+#define SAVEFILE_CI8_THUMBNAILS 0
+#endif
 
+#if SAVEFILE_CI8_THUMBNAILS
+typedef u8 ThumbnailPixel;
+#define THUMBNAIL_IMAGE_SPACE    1024
+#else
+typedef u16 ThumbnailPixel;
 #define THUMBNAIL_IMAGE_SPACE    2048
+#endif
+
+#define THUMBNAIL_IMAGE_SIZE    (SAVE_SLOT_IMAGE_W * SAVE_SLOT_IMAGE_H * sizeof(ThumbnailPixel))
 
 #define SAVE_SLOT_SIZE  (MAX_CHECKPOINT_SIZE + THUMBNAIL_IMAGE_SPACE)
 
 #define SCREEN_SHOT_SRAM(slotIndex)     (((slotIndex) + 1) * SAVE_SLOT_SIZE + MAX_CHECKPOINT_SIZE + SRAM_START_ADDR)
 
-#define SAVEFILE_HEADER 0xDEF5
+// changes whenever the checkpoint format changes so old saves are cleared
+#if SAVEFILE_CI8_THUMBNAILS
+#define SAVEFILE_HEADER 0xDEF7
+#else
+#define SAVEFILE_HEADER 0xDEF6
+#endif
 
 // first save slot is always reserved for auto save
 #define MAX_SAVE_SLOTS  ((int)(SRAM_SIZE / SAVE_SLOT_SIZE) - 1)
@@ -88,11 +104,14 @@ extern struct SaveData gSaveData;
 extern int gCurrentTestSubject;
 
 void savefileLoad();
+// queues a write of gSaveData, it is copied so it can keep changing
 void savefileSave();
+int savefileIsSaving();
+void savefileWaitForSave();
 
 void savefileDeleteGame(int slotIndex);
 
-void savefileSaveGame(Checkpoint checkpoint, u16* screenshot, int testChamberIndex, int subjectNumber, int slotIndex);
+void savefileSaveGame(Checkpoint checkpoint, ThumbnailPixel* screenshot, int testChamberIndex, int subjectNumber, int slotIndex);
 int savefileListSaves(struct SaveSlotInfo* slots, int includeAuto);
 int savefileNextTestSubject();
 int savefileSuggestedSlot(int testSubject);
@@ -103,9 +122,13 @@ void savefileMarkChapterProgress(int chamberNumber);
 int savefileFirstFreeSlot();
 
 void savefileLoadGame(int slot, Checkpoint checkpoint, int* testChamberIndex, int* subjectNumber);
-void savefileLoadScreenshot(u16* target, u16* location);
+void savefileLoadScreenshot(ThumbnailPixel* target, ThumbnailPixel* location);
+
+extern ThumbnailPixel gScreenGrabBuffer[SAVE_SLOT_IMAGE_W * SAVE_SLOT_IMAGE_H];
 
-extern u16 gScreenGrabBuffer[SAVE_SLOT_IMAGE_W * SAVE_SLOT_IMAGE_H];
+#if SAVEFILE_CI8_THUMBNAILS
+extern u16 gThumbnailPalette[256];
+#endif
 
 void savefileGrabScreenshot();
 
@@ -4,20 +4,82 @@
 #include "../decor/decor_object_list.h"
 #include "../util/memory.h"
 #include "../levels/levels.h"
+#include "../math/mathf.h"
 
 #ifdef PORTAL64_WITH_DEBUGGER
 #include "../debugger/debugger.h"
 #endif
 
+#define ROTATION_SAVE_SCALE     32767.0f
+
+void serializeRotation(struct Serializer* serializer, SerializeAction action, struct Quaternion* rotation) {
+    // rotations drift off unit length while simulating, so a component
+    // over 1 would wrap around when converted to a short
+    struct Quaternion normalized;
+    quatNormalize(rotation, &normalized);
+
+    short packed[4];
+    packed[0] = (short)(clampf(normalized.x, -1.0f, 1.0f) * ROTATION_SAVE_SCALE);
+    packed[1] = (short)(clampf(normalized.y, -1.0f, 1.0f) * ROTATION_SAVE_SCALE);
+    packed[2] = (short)(clampf(normalized.z, -1.0f, 1.0f) * ROTATION_SAVE_SCALE);
+    packed[3] = (short)(clampf(normalized.w, -1.0f, 1.0f) * ROTATION_SAVE_SCALE);
+    action(serializer, packed, sizeof(packed));
+}
+
+void deserializeRotation(struct Serializer* serializer, struct Quaternion* rotation) {
+    short packed[4];
+    serializeRead(serializer, packed, sizeof(packed));
+    rotation->x = packed[0] * (1.0f / ROTATION_SAVE_SCALE);
+    rotation->y = packed[1] * (1.0f / ROTATION_SAVE_SCALE);
+    rotation->z = packed[2] * (1.0f / ROTATION_SAVE_SCALE);
+    rotation->w = packed[3] * (1.0f / ROTATION_SAVE_SCALE);
+    quatNormalize(rotation, rotation);
+}
+
+// position is kept at full precision so objects dont settle into each other
+void serializeTransform(struct Serializer* serializer, SerializeAction action, struct Transform* transform) {
+    action(serializer, &transform->position, sizeof(struct Vector3));
+    serializeRotation(serializer, action, &transform->rotation);
+}
+
+void deserializeTransform(struct Serializer* serializer, struct Transform* transform) {
+    serializeRead(serializer, &transform->position, sizeof(struct Vector3));
+    deserializeRotation(serializer, &transform->rotation);
+}
+
+// most objects are at rest when a checkpoint is saved
+void serializeVelocity(struct Serializer* serializer, SerializeAction action, struct RigidBody* rigidBody) {
+    char isStill = vector3IsZero(&rigidBody->velocity) && vector3IsZero(&rigidBody->angularVelocity);
+    action(serializer, &isStill, sizeof(isStill));
+
+    if (!isStill) {
+        action(serializer, &rigidBody->velocity, sizeof(struct Vector3));
+        action(serializer, &rigidBody->angularVelocity, sizeof(struct Vector3));
+    }
+}
+
+void deserializeVelocity(struct Serializer* serializer, struct RigidBody* rigidBody) {
+    char isStill;
+    serializeRead(serializer, &isStill, sizeof(isStill));
+
+    if (isStill) {
+        rigidBody->velocity = gZeroVec;
+        rigidBody->angularVelocity = gZeroVec;
+    } else {
+        serializeRead(serializer, &rigidBody->velocity, sizeof(struct Vector3));
+        serializeRead(serializer, &rigidBody->angularVelocity, sizeof(struct Vector3));
+    }
+}
+
 void playerSerialize(struct Serializer* serializer, SerializeAction action, struct Player* player) {
-    action(serializer, &player->lookTransform, sizeof(struct PartialTransform));
+    serializeTransform(serializer, action, &player->lookTransform);
     action(serializer, &player->body.velocity, sizeof(player->body.velocity));
     action(serializer, &player->body.currentRoom, sizeof(player->body.currentRoom));
     action(serializer, &player->flags, sizeof(player->flags));
 }
 
 void playerDeserialize(struct Serializer* serializer, struct Player* player) {
-    serializeRead(serializer, &player->lookTransform, sizeof(struct PartialTransform));
+    deserializeTransform(serializer, &player->lookTransform);
     player->body.transform.position = player->lookTransform.position;
     serializeRead(serializer, &player->body.velocity, sizeof(player->body.velocity));
     serializeRead(serializer, &player->body.currentRoom, sizeof(player->body.currentRoom));
@@ -114,6 +176,42 @@ void buttonsSerializeRW(struct Serializer* serializer, SerializeAction action, s
     }
 }
 
+enum DecorSaveFlags {
+    // the original transform came from the level definition
+    DecorSaveFlagsFromLevel = (1 << 0),
+    // hasnt moved from the original transform
+    DecorSaveFlagsAtOrigin = (1 << 1),
+};
+
+short decorFindLevelIndex(struct DecorObject* entry, short id) {
+    for (int i = 0; i < gCurrentLevel->decorCount; ++i) {
+        struct DecorDefinition* decorDef = &gCurrentLevel->decor[i];
+
+        if (decorDef->decorId == id && 
+            decorDef->roomIndex == entry->originalRoom &&
+            vector3Equals(&decorDef->position, &entry->originalPosition) &&
+            decorDef->rotation.x == entry->originalRotation.x &&
+            decorDef->rotation.y == entry->originalRotation.y &&
+            decorDef->rotation.z == entry->originalRotation.z &&
+            decorDef->rotation.w == entry->originalRotation.w) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+int decorIsAtOrigin(struct DecorObject* entry) {
+    struct Quaternion* rotation = &entry->rigidBody.transform.rotation;
+
+    return vector3Equals(&entry->rigidBody.transform.position, &entry->originalPosition) &&
+        rotation->x == entry->originalRotation.x &&
+        rotation->y == entry->originalRotation.y &&
+        rotation->z == entry->originalRotation.z &&
+        rotation->w == entry->originalRotation.w &&
+        entry->rigidBody.currentRoom == entry->originalRoom;
+}
+
 void decorSerialize(struct Serializer* serializer, SerializeAction action, struct Scene* scene) {
     short countAsShort = 0;
     short heldObject = -1;
@@ -143,18 +241,35 @@ void decorSerialize(struct Serializer* serializer, SerializeAction action, struc
         }
 
         short id = decorIdForObjectDefinition(entry->definition);
+        short levelIndex = decorFindLevelIndex(entry, id);
+        char flags = 0;
+
+        if (levelIndex != -1) {
+            flags |= DecorSaveFlagsFromLevel;
+        }
+
+        if (decorIsAtOrigin(entry)) {
+            flags |= DecorSaveFlagsAtOrigin;
+        }
 
         action(serializer, &id, sizeof(short));
+        action(serializer, &flags, sizeof(char));
+
+        if (flags & DecorSaveFlagsFromLevel) {
+            action(serializer, &levelIndex, sizeof(short));
+        } else {
+            action(serializer, &entry->originalPosition, sizeof(struct Vector3));
+            action(serializer, &entry->originalRotation, sizeof(struct Quaternion));
+            action(serializer, &entry->originalRoom, sizeof(short));
+        }
 
-        action(serializer, &entry->originalPosition, sizeof(struct Vector3));
-        action(serializer, &entry->originalRotation, sizeof(struct Quaternion));
-        action(serializer, &entry->originalRoom, sizeof(short));
+        if (!(flags & DecorSaveFlagsAtOrigin)) {
+            serializeTransform(serializer, action, &entry->rigidBody.transform);
+            action(serializer, &entry->rigidBody.currentRoom, sizeof(short));
+        }
 
-        action(serializer, &entry->rigidBody.transform, sizeof(struct PartialTransform));
-        action(serializer, &entry->rigidBody.velocity, sizeof(struct Vector3));
-        action(serializer, &entry->rigidBody.angularVelocity, sizeof(struct Vector3));
+        serializeVelocity(serializer, action, &entry->rigidBody);
         action(serializer, &entry->rigidBody.flags, sizeof(enum RigidBodyFlags));
-        action(serializer, &entry->rigidBody.currentRoom, sizeof(short));
 
         entry->rigidBody.flags &= ~RigidBodyIsSleeping;
         entry->rigidBody.sleepFrames = IDLE_SLEEP_FRAMES;
@@ -180,24 +295,38 @@ void decorDeserialize(struct Serializer* serializer, struct Scene* scene) {
 
     for (int i = 0; i < countAsShort; ++i) {
         short id;
+        char flags;
 
         serializeRead(serializer, &id, sizeof(short));
+        serializeRead(serializer, &flags, sizeof(char));
 
         struct Transform transform;
         short originalRoom;
 
-        serializeRead(serializer, &transform.position, sizeof(struct Vector3));
-        serializeRead(serializer, &transform.rotation, sizeof(struct Quaternion));
+        if (flags & DecorSaveFlagsFromLevel) {
+            short levelIndex;
+            serializeRead(serializer, &levelIndex, sizeof(short));
+            struct DecorDefinition* decorDef = &gCurrentLevel->decor[levelIndex];
+            transform.position = decorDef->position;
+            transform.rotation = decorDef->rotation;
+            originalRoom = decorDef->roomIndex;
+        } else {
+            serializeRead(serializer, &transform.position, sizeof(struct Vector3));
+            serializeRead(serializer, &transform.rotation, sizeof(struct Quaternion));
+            serializeRead(serializer, &originalRoom, sizeof(short));
+        }
+
         transform.scale = gOneVec;
-        serializeRead(serializer, &originalRoom, sizeof(short));
 
         struct DecorObject* entry = decorObjectNew(decorObjectDefinitionForId(id), &transform, originalRoom);
 
-        serializeRead(serializer, &entry->rigidBody.transform, sizeof(struct PartialTransform));
-        serializeRead(serializer, &entry->rigidBody.velocity, sizeof(struct Vector3));
-        serializeRead(serializer, &entry->rigidBody.angularVelocity, sizeof(struct Vector3));
+        if (!(flags & DecorSaveFlagsAtOrigin)) {
+            deserializeTransform(serializer, &entry->rigidBody.transform);
+            serializeRead(serializer, &entry->rigidBody.currentRoom, sizeof(short));
+        }
+
+        deserializeVelocity(serializer, &entry->rigidBody);
         serializeRead(serializer, &entry->rigidBody.flags, sizeof(enum RigidBodyFlags));
-        serializeRead(serializer, &entry->rigidBody.currentRoom, sizeof(short));
 
         scene->decor[i] = entry;
 
@@ -245,10 +374,9 @@ void boxDropperSerialize(struct Serializer* serializer, SerializeAction action,
             continue;
         }
 
-        action(serializer, &dropper->activeCube.rigidBody.transform, sizeof(struct PartialTransform));
+        serializeTransform(serializer, action, &dropper->activeCube.rigidBody.transform);
         action(serializer, &dropper->activeCube.rigidBody.currentRoom, sizeof(short));
-        action(serializer, &dropper->activeCube.rigidBody.velocity, sizeof(struct Vector3));
-        action(serializer, &dropper->activeCube.rigidBody.angularVelocity, sizeof(struct Vector3));
+        serializeVelocity(serializer, action, &dropper->activeCube.rigidBody);
         action(serializer, &dropper->activeCube.rigidBody.flags, sizeof(enum RigidBodyFlags));
     }
 }
@@ -267,14 +395,13 @@ void boxDropperDeserialize(struct Serializer* serializer, struct Scene* scene) {
 
         struct Transform cubePosition;
         short cubeRoom;
-        serializeRead(serializer, &cubePosition, sizeof(struct PartialTransform));
+        deserializeTransform(serializer, &cubePosition);
         cubePosition.scale = gOneVec;
         serializeRead(serializer, &cubeRoom, sizeof(short));
 
         decorObjectInit(&dropper->activeCube, decorObjectDefinitionForId(DECOR_TYPE_CUBE_UNIMPORTANT), &cubePosition, cubeRoom);
 
-        serializeRead(serializer, &dropper->activeCube.rigidBody.velocity, sizeof(struct Vector3));
-        serializeRead(serializer, &dropper->activeCube.rigidBody.angularVelocity, sizeof(struct Vector3));
+        deserializeVelocity(serializer, &dropper->activeCube.rigidBody);
         serializeRead(serializer, &dropper->activeCube.rigidBody.flags, sizeof(enum RigidBodyFlags));
 
         dropper->activeCube.rigidBody.flags &= ~RigidBodyIsSleeping;
@@ -391,7 +518,7 @@ void sceneAnimatorSerialize(struct Serializer* serializer, SerializeAction actio
 
         struct SKArmature* armature = &scene->animator.armatures[i];
         for (int boneIndex = 0; boneIndex < armature->numberOfBones; ++boneIndex) {
-            action(serializer, &armature->pose[boneIndex], sizeof(struct PartialTransform));
+            serializeTransform(serializer, action, &armature->pose[boneIndex]);
         }
 
         struct SKAnimator* animator = &scene->animator.animators[i];
@@ -431,7 +558,7 @@ void sceneAnimatorDeserialize(struct Serializer* serializer, struct Scene* scene
 
         struct SKArmature* armature = &scene->animator.armatures[i];
         for (int boneIndex = 0; boneIndex < armature->numberOfBones; ++boneIndex) {
-            serializeRead(serializer, &armature->pose[boneIndex], sizeof(struct PartialTransform));
+            deserializeTransform(serializer, &armature->pose[boneIndex]);
         }
 
         struct SKAnimator* animator = &scene->animator.animators[i];
@@ -114,4 +114,8 @@ void ballLauncherUpdate(struct BallLauncher* launcher) {
             ballTurnOnCollision(&launcher->currentBall);
         }
     }
+}
+
+int ballLauncherIsAwake(struct BallLauncher* launcher) {
+    return !ballIsCaught(&launcher->currentBall) || skAnimatorIsRunning(&launcher->animator);
 }
\ No newline at end of file
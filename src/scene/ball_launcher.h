@@ -24,5 +24,6 @@ struct BallLauncher {
 void ballLauncherInit(struct BallLauncher* launcher, struct BallLauncherDefinition* definition);
 
 void ballLauncherUpdate(struct BallLauncher* launcher);
+int ballLauncherIsAwake(struct BallLauncher* launcher);
 
 #endif
\ No newline at end of file
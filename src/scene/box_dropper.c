@@ -166,4 +166,13 @@ void boxDropperUpdate(struct BoxDropper* dropper) {
         dropper->flags |= BoxDropperFlagsSignalWasSet;
     }
 
+}
+
+int boxDropperIsAwake(struct BoxDropper* dropper) {
+    int signalWasSet = (dropper->flags & BoxDropperFlagsSignalWasSet) != 0;
+
+    return (dropper->flags & (BoxDropperFlagsCubeIsActive | BoxDropperFlagsCubeRequested)) ||
+        dropper->reloadTimer > 0.0f ||
+        skAnimatorIsRunning(&dropper->animator) ||
+        signalWasSet != signalsRead(dropper->signalIndex);
 }
\ No newline at end of file
@@ -34,5 +34,6 @@ struct BoxDropper {
 void boxDropperInit(struct BoxDropper* dropper, struct BoxDropperDefinition* definition);
 
 void boxDropperUpdate(struct BoxDropper* dropper);
+int boxDropperIsAwake(struct BoxDropper* dropper);
 
 #endif
\ No newline at end of file
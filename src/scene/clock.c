@@ -122,7 +122,8 @@ void clockRenderRender(void* data, struct DynamicRenderDataList* renderList, str
 
 void clockInit(struct Clock* clock, struct ClockDefinition* definition) {
     dynamicAssetModelPreload(SIGNAGE_CLOCK_DYNAMIC_MODEL);
-    dynamicAssetModelPreload(SIGNAGE_CLOCK_DIGITS_DYNAMIC_MODEL);
+    // the digit uvs are changed in place so a reload would get out of sync with gCurrentClockDigits
+    dynamicAssetModelPin(SIGNAGE_CLOCK_DIGITS_DYNAMIC_MODEL);
 
     clock->transform.position = definition->position;
     clock->transform.rotation = definition->rotation;
@@ -166,6 +166,11 @@ void doorUpdate(struct Door* door) {
     }
 }
 
+int doorIsAwake(struct Door* door) {
+    int isOpen = (door->flags & DoorFlagsIsOpen) != 0;
+    return skAnimatorIsRunning(&door->animator) || isOpen != signalsRead(door->signalIndex);
+}
+
 void doorCheckForOpenState(struct Door* door) {
     struct DoorTypeDefinition* typeDefinition = &gDoorTypeDefinitions[door->doorDefinition->doorType];
 
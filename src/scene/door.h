@@ -38,6 +38,7 @@ struct Door {
 
 void doorInit(struct Door* door, struct DoorDefinition* doorDefinition, struct World* world);
 void doorUpdate(struct Door* door);
+int doorIsAwake(struct Door* door);
 void doorCheckForOpenState(struct Door* door);
 
 #endif
\ No newline at end of file
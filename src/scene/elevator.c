@@ -10,6 +10,7 @@
 #include "../controls/rumble_pak.h"
 
 #include "../savefile/checkpoint.h"
+#include "../levels/levels.h"
 
 #include "../../build/assets/models/props/round_elevator_collision.h"
 #include "../../build/assets/models/props/round_elevator_interior.h"
@@ -223,6 +224,11 @@ int elevatorUpdate(struct Elevator* elevator, struct Player* player) {
         player->shakeTimer = SHAKE_DURATION;
         rumblePakClipPlay(&gElevatorRumbleWave);
         elevator->flags |= ElevatorFlagsMovingSoundPlayed;
+
+        if (elevator->targetElevator >= gScene.elevatorCount) {
+            // load the next level while the elevator is moving
+            levelPrefetch(NEXT_LEVEL);
+        }
     }
 
     elevator->openAmount = mathfMoveTowards(elevator->openAmount, shouldBeOpen ? 1.0f : 0.0f, OPEN_SPEED * FIXED_DELTA_TIME);
@@ -6,6 +6,7 @@
 #include "../physics/collision_scene.h"
 #include "../util/dynamic_asset_loader.h"
 #include "../math/mathf.h"
+#include "update_scheduler.h"
 
 #include "../../build/assets/models/dynamic_model_list.h"
 
@@ -218,4 +219,9 @@ void fizzlerUpdate(struct Fizzler* fizzler) {
     }
 
     osWritebackDCache(fizzler->modelVertices, sizeof(Vtx) * maxVertex);
+}
+
+// the particles are only visual
+int fizzlerIsAwake(struct Fizzler* fizzler) {
+    return updateSchedulerIsRoomActive(fizzler->rigidBody.currentRoom);
 }
\ No newline at end of file
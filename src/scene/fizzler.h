@@ -32,5 +32,6 @@ struct Fizzler {
 
 void fizzlerInit(struct Fizzler* fizzler, struct Transform* transform, float width, float height, int room);
 void fizzlerUpdate(struct Fizzler* fizzler);
+int fizzlerIsAwake(struct Fizzler* fizzler);
 
 #endif
\ No newline at end of file
@@ -117,6 +117,10 @@ void pedestalUpdate(struct Pedestal* pedestal) {
     quatAxisComplex(&gUp, &pedestal->currentRotation, &pedestal->armature.pose[PEDESTAL_HOLDER_BONE].rotation);
 }
 
+int pedestalIsAwake(struct Pedestal* pedestal) {
+    return (pedestal->flags & (PedestalFlagsIsPointing | PedestalFlagsAlreadyMoving)) || skAnimatorIsRunning(&pedestal->animator);
+}
+
 void pedestalHide(struct Pedestal* pedestal) {
     soundPlayerPlay(soundsReleaseCube, 3.0f, 0.5f, &pedestal->transform.position, &gZeroVec, SoundTypeAll);
     hudShowSubtitle(&gScene.hud, WEAPON_PORTALGUN_POWERUP, SubtitleTypeCaption);
@@ -29,6 +29,7 @@ struct Pedestal {
 
 void pedestalInit(struct Pedestal* pedestal, struct PedestalDefinition* definition);
 void pedestalUpdate(struct Pedestal* pedestal);
+int pedestalIsAwake(struct Pedestal* pedestal);
 
 void pedestalHide(struct Pedestal* pedestal);
 void pedestalPointAt(struct Pedestal* pedestal, struct Vector3* target);
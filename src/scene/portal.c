@@ -165,11 +165,11 @@ int portalSurfaceCutNewHole(struct Portal* portal, int portalIndex) {
         scaledLoop[i].y = ((portal->originCentertedLoop[i].y * fixedPointScale) >> 16) + portal->fullSizeLoopCenter.y;
     }
 
-    struct PortalSurface* currentSurface = &gCurrentLevel->portalSurfaces[portal->portalSurfaceIndex];
-
     struct PortalSurface newSurface;
 
-    if (!portalSurfacePokeHole(currentSurface, scaledLoop, &newSurface)) {
+    // only the fully grown hole is cached, the holes
+    // while the portal is opening are only used once
+    if (!portalSurfacePokeHoleCached(portal->portalSurfaceIndex, scaledLoop, portal->scale >= 1.0f, &newSurface)) {
         return 0;
     }
     
@@ -10,6 +10,7 @@
 #include "../util/memory.h"
 
 #define MAX_PENDING_PORTAL_CLEANUP  4
+#define PORTAL_HOLE_CACHE_SIZE      4
 
 #define PORTAL_HOLE_SCALE_X  0.945f
 #define PORTAL_HOLE_SCALE_Y  0.795f
@@ -45,14 +46,135 @@ void portalSurfaceCheckCleanupQueue() {
     }
 }
 
+struct PortalSurfaceHoleCacheEntry {
+    struct PortalSurface surface;
+    struct Vector2s16 loop[PORTAL_LOOP_SIZE];
+    short portalSurfaceIndex;
+    unsigned short lastUsed;
+};
+
+struct PortalSurfaceHoleCacheEntry gPortalSurfaceHoleCache[PORTAL_HOLE_CACHE_SIZE];
+unsigned short gPortalSurfaceHoleCacheTime;
+
+void portalSurfaceHoleCacheReset() {
+    // called when the heap is reset so the surfaces are
+    // dropped instead of freed
+    for (int i = 0; i < PORTAL_HOLE_CACHE_SIZE; ++i) {
+        gPortalSurfaceHoleCache[i].portalSurfaceIndex = -1;
+        gPortalSurfaceHoleCache[i].surface.shouldCleanup = 0;
+    }
+}
+
 void portalSurfaceCleanupQueueInit() {
     for (int searchIterator = 0; searchIterator < MAX_PENDING_PORTAL_CLEANUP; ++searchIterator) {
         gPortalSurfaceCleanupQueue[searchIterator].shouldCleanup = 0;
     }
+
+    portalSurfaceHoleCacheReset();
 }
 
 struct PortalSurfaceReplacement gPortalSurfaceReplacements[2];
 
+int portalSurfaceHoleCacheIsInUse(struct PortalSurfaceHoleCacheEntry* entry) {
+    if (entry->portalSurfaceIndex == -1) {
+        return 0;
+    }
+
+    if (gCurrentLevel->portalSurfaces[entry->portalSurfaceIndex].triangles == entry->surface.triangles) {
+        return 1;
+    }
+
+    for (int i = 0; i < 2; ++i) {
+        struct PortalSurfaceReplacement* replacement = &gPortalSurfaceReplacements[i];
+
+        if ((replacement->flags & PortalSurfaceReplacementFlagsIsEnabled) && replacement->previousSurface.triangles == entry->surface.triangles) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+int portalSurfaceHoleCacheLoopMatches(struct PortalSurfaceHoleCacheEntry* entry, struct Vector2s16* loop) {
+    for (int i = 0; i < PORTAL_LOOP_SIZE; ++i) {
+        if (entry->loop[i].equalTest != loop[i].equalTest) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+int portalSurfaceIsOriginal(int portalSurfaceIndex) {
+    for (int i = 0; i < 2; ++i) {
+        struct PortalSurfaceReplacement* replacement = &gPortalSurfaceReplacements[i];
+
+        if ((replacement->flags & PortalSurfaceReplacementFlagsIsEnabled) && replacement->portalSurfaceIndex == portalSurfaceIndex) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+int portalSurfacePokeHoleCached(int portalSurfaceIndex, struct Vector2s16* loop, int shouldCache, struct PortalSurface* result) {
+    struct PortalSurface* surface = &gCurrentLevel->portalSurfaces[portalSurfaceIndex];
+
+    // only holes cut into the level's own surface are cached, a hole
+    // cut next to the other portal depends on where that portal is
+    if (!portalSurfaceIsOriginal(portalSurfaceIndex)) {
+        return portalSurfacePokeHole(surface, loop, result);
+    }
+
+    ++gPortalSurfaceHoleCacheTime;
+
+    struct PortalSurfaceHoleCacheEntry* oldest = NULL;
+
+    for (int i = 0; i < PORTAL_HOLE_CACHE_SIZE; ++i) {
+        struct PortalSurfaceHoleCacheEntry* entry = &gPortalSurfaceHoleCache[i];
+
+        if (entry->portalSurfaceIndex == portalSurfaceIndex && portalSurfaceHoleCacheLoopMatches(entry, loop)) {
+            entry->lastUsed = gPortalSurfaceHoleCacheTime;
+            *result = entry->surface;
+            // the cache owns the memory
+            result->shouldCleanup = 0;
+            return 1;
+        }
+
+        if (portalSurfaceHoleCacheIsInUse(entry)) {
+            continue;
+        }
+
+        if (!oldest || (unsigned short)(gPortalSurfaceHoleCacheTime - entry->lastUsed) > (unsigned short)(gPortalSurfaceHoleCacheTime - oldest->lastUsed)) {
+            oldest = entry;
+        }
+    }
+
+    if (!portalSurfacePokeHole(surface, loop, result)) {
+        return 0;
+    }
+
+    if (!shouldCache || !oldest) {
+        return 1;
+    }
+
+    // the display list could still be in use so
+    // let the cleanup queue free it
+    portalSurfaceCleanup(&oldest->surface);
+
+    oldest->surface = *result;
+    oldest->portalSurfaceIndex = portalSurfaceIndex;
+    oldest->lastUsed = gPortalSurfaceHoleCacheTime;
+
+    for (int i = 0; i < PORTAL_LOOP_SIZE; ++i) {
+        oldest->loop[i] = loop[i];
+    }
+
+    result->shouldCleanup = 0;
+
+    return 1;
+}
+
 
 int portalSurfaceGetSurfaceIndex(int portalIndex) {
     if (gPortalSurfaceReplacements[portalIndex].flags & PortalSurfaceReplacementFlagsIsEnabled) {
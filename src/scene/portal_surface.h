@@ -66,6 +66,9 @@ int portalSurfaceGenerate(struct PortalSurface* surface, int surfaceIndex, struc
 
 void portalSurfaceCleanup(struct PortalSurface* portalSurface);
 
+// results are only cached if shouldCache is set, cached results are owned by the cache
+int portalSurfacePokeHoleCached(int portalSurfaceIndex, struct Vector2s16* loop, int shouldCache, struct PortalSurface* result);
+
 int portalSurfaceAdjustPosition(struct PortalSurface* surface, struct Transform* portalAt, struct Vector2s16* output, struct Vector2s16* outlineLoopOutput);
 
 struct PortalSurface* portalSurfaceGetOriginalSurface(int portalSurfaceIndex, int portalIndex);
@@ -0,0 +1,180 @@
+#include "portal_surface_fuzzer.h"
+
+#ifdef PORTAL64_WITH_SURFACE_FUZZER
+
+#include <ultra64.h>
+#include <string.h>
+#include <math.h>
+
+#include "portal.h"
+#include "portal_surface.h"
+#include "portal_surface_generator.h"
+#include "../levels/levels.h"
+#include "../math/mathf.h"
+#include "../math/quaternion.h"
+#include "../util/memory.h"
+
+#ifdef PORTAL64_WITH_DEBUGGER
+#include "../../debugger/serial.h"
+#endif
+
+#define MIN_FUZZ_SCALE  0.1f
+
+struct PortalSurfaceFuzzResults {
+    int attempts;
+    int rejected;
+    int failed;
+    int malformed;
+    int totalUsec;
+    int maxUsec;
+    int worstSurface;
+};
+
+static void portalSurfaceFuzzReport(char* message, int messageLen) {
+#ifdef PORTAL64_WITH_DEBUGGER
+    gdbSendMessage(GDBDataTypeText, message, messageLen);
+#endif
+}
+
+void portalSurfaceFuzzRandomPoint(struct PortalSurface* surface, struct Vector2s16* output) {
+    struct Vector2s16 min = surface->vertices[0];
+    struct Vector2s16 max = surface->vertices[0];
+
+    for (int i = 1; i < surface->vertexCount; ++i) {
+        min.x = MIN(min.x, surface->vertices[i].x);
+        min.y = MIN(min.y, surface->vertices[i].y);
+        max.x = MAX(max.x, surface->vertices[i].x);
+        max.y = MAX(max.y, surface->vertices[i].y);
+    }
+
+    output->x = randomInRange(min.x, max.x + 1);
+    output->y = randomInRange(min.y, max.y + 1);
+}
+
+// mirrors how sceneOpenPortalFromHit orients a portal
+void portalSurfaceFuzzTransform(struct PortalSurface* surface, struct Vector2s16* at, int portalIndex, struct Transform* output) {
+    struct Vector3 normal;
+    vector3Cross(&surface->right, &surface->up, &normal);
+
+    if (portalIndex == 1) {
+        vector3Negate(&normal, &normal);
+    }
+
+    portalSurfaceInverse(surface, at, &output->position);
+    output->scale = gOneVec;
+    quatLook(&normal, fabsf(normal.y) < 0.8f ? &gUp : &surface->up, &output->rotation);
+}
+
+void portalSurfaceFuzzSingle(struct PortalSurface* surface, int surfaceIndex, struct PortalSurfaceFuzzResults* results) {
+    struct Vector2s16 at;
+    struct Transform portalAt;
+    int portalIndex = randomInRange(0, 2);
+
+    ++results->attempts;
+
+    portalSurfaceFuzzRandomPoint(surface, &at);
+    portalSurfaceFuzzTransform(surface, &at, portalIndex, &portalAt);
+
+    struct Vector2s16 center;
+    struct Vector2s16 loop[PORTAL_LOOP_SIZE];
+
+    // positions the game would never place a portal at don't count
+    if (!portalSurfaceIsInside(surface, &portalAt, portalIndex) || !portalSurfaceAdjustPosition(surface, &portalAt, &center, loop)) {
+        ++results->rejected;
+        return;
+    }
+
+    // same scaling as a portal that is still opening
+    int fixedPointScale = (int)(0x10000 * randomInRangef(MIN_FUZZ_SCALE, 1.0f));
+
+    for (int i = 0; i < PORTAL_LOOP_SIZE; ++i) {
+        loop[i].x = (((loop[i].x - center.x) * fixedPointScale) >> 16) + center.x;
+        loop[i].y = (((loop[i].y - center.y) * fixedPointScale) >> 16) + center.y;
+    }
+
+    struct PortalSurface result;
+
+    int malformedBefore = gPortalSurfacePokeStats.failures[PortalSurfacePokeFailureMalformed];
+
+    OSTime start = osGetTime();
+    int success = portalSurfacePokeHole(surface, loop, &result);
+    int usec = (int)OS_CYCLES_TO_USEC(osGetTime() - start);
+
+    results->totalUsec += usec;
+
+    if (usec > results->maxUsec) {
+        results->maxUsec = usec;
+        results->worstSurface = surfaceIndex;
+    }
+
+    if (!success) {
+        // portalSurfacePokeHole checks the builder with portalSurfaceIsWellFormed
+        // before handing back a result so malformed surfaces show up as a failure
+        int isMalformed = gPortalSurfacePokeStats.failures[PortalSurfacePokeFailureMalformed] != malformedBefore;
+
+        if (isMalformed) {
+            ++results->malformed;
+        } else {
+            ++results->failed;
+        }
+
+        char message[64];
+        int messageLen = sprintf(message, "poke %s surface %d at %d %d", isMalformed ? "malformed" : "failed", surfaceIndex, center.x, center.y);
+        portalSurfaceFuzzReport(message, messageLen);
+        return;
+    }
+
+    // never handed to the renderer so it can be freed right away
+    free(result.vertices);
+    free(result.edges);
+    free(result.gfxVertices);
+    free(result.triangles);
+}
+
+void portalSurfaceFuzzLevel(int pokesPerSurface) {
+    struct PortalSurfaceFuzzResults results;
+    zeroMemory(&results, sizeof(results));
+    zeroMemory(&gPortalSurfacePokeStats, sizeof(gPortalSurfacePokeStats));
+    results.worstSurface = -1;
+
+    for (int surfaceIndex = 0; surfaceIndex < gCurrentLevel->portalSurfaceCount; ++surfaceIndex) {
+        struct PortalSurface* surface = &gCurrentLevel->portalSurfaces[surfaceIndex];
+
+        for (int i = 0; i < pokesPerSurface; ++i) {
+            portalSurfaceFuzzSingle(surface, surfaceIndex, &results);
+        }
+    }
+
+    int poked = results.attempts - results.rejected;
+
+    char message[64];
+    int messageLen = sprintf(message, "fuzz pokes %d failed %d malformed %d", poked, results.failed, results.malformed);
+    portalSurfaceFuzzReport(message, messageLen);
+
+    messageLen = sprintf(message, "fuzz usec avg %d max %d surface %d", poked ? results.totalUsec / poked : 0, results.maxUsec, results.worstSurface);
+    portalSurfaceFuzzReport(message, messageLen);
+
+    for (int i = 0; i < PortalSurfacePokeFailureCount; ++i) {
+        messageLen = sprintf(message, "fuzz failure %d count %d", i, gPortalSurfacePokeStats.failures[i]);
+        portalSurfaceFuzzReport(message, messageLen);
+    }
+
+    messageLen = sprintf(
+        message, 
+        "fuzz edges +%d vertices +%d stack %d", 
+        gPortalSurfacePokeStats.maxAddedEdges, 
+        gPortalSurfacePokeStats.maxAddedVertices, 
+        gPortalSurfacePokeStats.maxStackUsage
+    );
+    portalSurfaceFuzzReport(message, messageLen);
+
+    messageLen = sprintf(
+        message, 
+        "fuzz capacity exceeded edges %d vertices %d", 
+        gPortalSurfacePokeStats.edgeCapacityExceeded, 
+        gPortalSurfacePokeStats.vertexCapacityExceeded
+    );
+    portalSurfaceFuzzReport(message, messageLen);
+}
+
+#endif
@@ -0,0 +1,11 @@
+#ifndef __SCENE_PORTAL_SURFACE_FUZZER_H__
+#define __SCENE_PORTAL_SURFACE_FUZZER_H__
+
+#define PORTAL_SURFACE_FUZZ_POKES   64
+
+// pokes portals at random positions into every portal surface
+// of the current level and reports any that fail or come out
+// malformed. Only built with PORTAL64_WITH_SURFACE_FUZZER
+void portalSurfaceFuzzLevel(int pokesPerSurface);
+
+#endif
@@ -17,6 +17,13 @@
 
 #define VERY_FAR_AWAY   1e15f
 
+#ifdef PORTAL64_WITH_SURFACE_FUZZER
+struct PortalSurfacePokeStats gPortalSurfacePokeStats;
+#define POKE_HOLE_FAIL(reason)  do { ++gPortalSurfacePokeStats.failures[reason]; goto error; } while (0)
+#else
+#define POKE_HOLE_FAIL(reason)  goto error
+#endif
+
 int portalSurfaceFindEnclosingFace(struct PortalSurface* surface, struct Vector2s16* aroundPoint) {
     float minDistance = VERY_FAR_AWAY;
     int result = -1;
@@ -115,6 +122,13 @@ int portalSurfaceIsWellFormed(struct PortalSurfaceBuilder* surfaceBuilder) {
             continue;
         }
 
+        if (edge->pointIndex >= surfaceBuilder->currentVertex || 
+            edge->nextEdge >= surfaceBuilder->currentEdge || 
+            edge->prevEdge >= surfaceBuilder->currentEdge || 
+            (edge->reverseEdge != NO_EDGE_CONNECTION && edge->reverseEdge >= surfaceBuilder->currentEdge)) {
+            return 0;
+        }
+
         struct SurfaceEdge* next = portalSurfaceGetEdge(surfaceBuilder, edge->nextEdge);
         struct SurfaceEdge* prev = portalSurfaceGetEdge(surfaceBuilder, edge->prevEdge);
         struct SurfaceEdge* reverse = edge->reverseEdge == NO_EDGE_CONNECTION ? NULL : portalSurfaceGetEdge(surfaceBuilder, edge->reverseEdge);
@@ -321,6 +335,9 @@ enum IntersectionType portalSurfaceIntersect(struct Vector2s16* pointA, struct V
 
 int portalSurfaceNewVertex(struct PortalSurfaceBuilder* surfaceBuilder, struct Vector2s16* point) {
     if (surfaceBuilder->currentVertex == ADDITIONAL_VERTEX_CAPACITY + surfaceBuilder->original->vertexCount) {
+#ifdef PORTAL64_WITH_SURFACE_FUZZER
+        ++gPortalSurfacePokeStats.vertexCapacityExceeded;
+#endif
         return -1;
     }
 
@@ -348,6 +365,9 @@ int portalSurfaceNewEdge(struct PortalSurfaceBuilder* surfaceBuilder, int isLoop
     }
 
     if (surfaceBuilder->currentEdge == ADDITIONAL_EDGE_CAPACITY + surfaceBuilder->original->edgeCount) {
+#ifdef PORTAL64_WITH_SURFACE_FUZZER
+        ++gPortalSurfacePokeStats.edgeCapacityExceeded;
+#endif
         return -1;
     }
 
@@ -1009,29 +1029,45 @@ int portalSurfacePokeHole(struct PortalSurface* surface, struct Vector2s16* loop
     zeroMemory(surfaceBuilder.isLoopEdge, edgeCapacity);
     memCopy(surfaceBuilder.gfxVertices, surface->gfxVertices, sizeof(Vtx) * surface->vertexCount);
 
+#ifdef PORTAL64_WITH_SURFACE_FUZZER
+    ++gPortalSurfacePokeStats.pokeCount;
+    gPortalSurfacePokeStats.maxStackUsage = MAX(gPortalSurfacePokeStats.maxStackUsage, (int)((char*)(surfaceBuilder.gfxVertices + surface->vertexCount + ADDITIONAL_EDGE_CAPACITY) - (char*)surfaceBuilder.vertices));
+#endif
+
     struct Vector2s16* prev = &loop[0];
 
-    surfaceBuilder.edgeOnSearchLoop = portalSurfaceFindEnclosingFace(surface, prev);
+    // edgeOnSearchLoop is a u8 so check for -1 before storing it
+    int enclosingFace = portalSurfaceFindEnclosingFace(surface, prev);
 
-    if (surfaceBuilder.edgeOnSearchLoop == -1) {
-        goto error;
+    if (enclosingFace == -1) {
+        POKE_HOLE_FAIL(PortalSurfacePokeFailureEnclosingFace);
     }
 
+    surfaceBuilder.edgeOnSearchLoop = enclosingFace;
+
     if (!portalSurfaceFindStartingPoint(&surfaceBuilder, prev)) {
-        goto error;
+        POKE_HOLE_FAIL(PortalSurfacePokeFailureStartingPoint);
     }
 
-    for (int index = 1; index <= PORTAL_LOOP_SIZE;) {
+    // every step either reaches the next loop point or lands on
+    // a vertex so anything past this is stuck in place
+    int maxSteps = surface->vertexCount + ADDITIONAL_VERTEX_CAPACITY + PORTAL_LOOP_SIZE;
+
+    for (int index = 1; index <= PORTAL_LOOP_SIZE; --maxSteps) {
         struct Vector2s16* next = &loop[index == PORTAL_LOOP_SIZE ? 0 : index];
 
+        if (maxSteps == 0) {
+            POKE_HOLE_FAIL(PortalSurfacePokeFailureIntersectLoop);
+        }
+
         if (!portalSurfaceFindNextLoop(&surfaceBuilder, next)) {
-            goto error;
+            POKE_HOLE_FAIL(PortalSurfacePokeFailureNextLoop);
         }
 
         struct Vector2s16* newPoint = portalSurfaceIntersectEdgeWithLoop(&surfaceBuilder, prev, next, index == PORTAL_LOOP_SIZE);
 
         if (!newPoint) {
-            goto error;
+            POKE_HOLE_FAIL(PortalSurfacePokeFailureIntersectLoop);
         }
 
         // check if the portal loop ever intersected an edge
@@ -1044,7 +1080,7 @@ int portalSurfacePokeHole(struct PortalSurface* surface, struct Vector2s16* loop
             struct SurfaceEdge* lastEdge = portalSurfaceGetEdge(&surfaceBuilder, lastEdgeIndex);
 
             if (firstEdge->reverseEdge == NO_EDGE_CONNECTION || lastEdge->reverseEdge == NO_EDGE_CONNECTION) {
-                goto error;
+                POKE_HOLE_FAIL(PortalSurfacePokeFailureInnerLoop);
             }
 
             struct SurfaceEdge* firstEdgeReverse = portalSurfaceGetEdge(&surfaceBuilder, firstEdge->reverseEdge);
@@ -1059,7 +1095,7 @@ int portalSurfacePokeHole(struct PortalSurface* surface, struct Vector2s16* loop
             --surfaceBuilder.currentVertex;
 
             if (!portalSurfaceJoinInnerLoopToOuterLoop(&surfaceBuilder)) {
-                goto error;
+                POKE_HOLE_FAIL(PortalSurfacePokeFailureJoinLoops);
             }
         }
 
@@ -1074,9 +1110,20 @@ int portalSurfacePokeHole(struct PortalSurface* surface, struct Vector2s16* loop
     portalSurfaceMarkHoleAsUsed(&surfaceBuilder);
 
     if (!portalSurfaceTriangulate(&surfaceBuilder)) {
-        goto error;
+        POKE_HOLE_FAIL(PortalSurfacePokeFailureTriangulate);
     }
 
+#if VERIFY_INTEGRITY
+    if (!portalSurfaceIsWellFormed(&surfaceBuilder)) {
+        POKE_HOLE_FAIL(PortalSurfacePokeFailureMalformed);
+    }
+#endif
+
+#ifdef PORTAL64_WITH_SURFACE_FUZZER
+    gPortalSurfacePokeStats.maxAddedEdges = MAX(gPortalSurfacePokeStats.maxAddedEdges, surfaceBuilder.currentEdge - surface->edgeCount);
+    gPortalSurfacePokeStats.maxAddedVertices = MAX(gPortalSurfacePokeStats.maxAddedVertices, surfaceBuilder.currentVertex - surface->vertexCount);
+#endif
+
     result->vertices = malloc(sizeof(struct Vector2s16) * surfaceBuilder.currentVertex);
     result->edges = malloc(sizeof(struct SurfaceEdge) * surfaceBuilder.currentEdge);
     result->edgeCount = surfaceBuilder.currentEdge;
@@ -38,6 +38,35 @@ struct PortalSurfaceBuilder {
     Vtx* gfxVertices;
 };
 
+#ifdef PORTAL64_WITH_SURFACE_FUZZER
+
+enum PortalSurfacePokeFailure {
+    PortalSurfacePokeFailureEnclosingFace,
+    PortalSurfacePokeFailureStartingPoint,
+    PortalSurfacePokeFailureNextLoop,
+    PortalSurfacePokeFailureIntersectLoop,
+    PortalSurfacePokeFailureInnerLoop,
+    PortalSurfacePokeFailureJoinLoops,
+    PortalSurfacePokeFailureTriangulate,
+    PortalSurfacePokeFailureMalformed,
+    PortalSurfacePokeFailureCount,
+};
+
+struct PortalSurfacePokeStats {
+    int pokeCount;
+    int failures[PortalSurfacePokeFailureCount];
+    int edgeCapacityExceeded;
+    int vertexCapacityExceeded;
+    int maxAddedEdges;
+    int maxAddedVertices;
+    int maxStackUsage;
+};
+
+extern struct PortalSurfacePokeStats gPortalSurfacePokeStats;
+
+#endif
+
+int portalSurfaceIsWellFormed(struct PortalSurfaceBuilder* surfaceBuilder);
 int portalSurfacePokeHole(struct PortalSurface* surface, struct Vector2s16* loop, struct PortalSurface* result);
 int portalSurfaceHasFlag(struct PortalSurfaceBuilder* surfaceBuilder, int edgeIndex, enum SurfaceEdgeFlags value);
 void portalSurfaceSetFlag(struct PortalSurfaceBuilder* surfaceBuilder, int edgeIndex, enum SurfaceEdgeFlags value);
@@ -208,7 +208,8 @@ struct DisplayListResult newGfxFromSurfaceBuilder(struct PortalSurfaceBuilder* s
 
     gfxBuilderCollectTriangles(&builderState, surfaceBuilder);
 
-    Gfx* tmpResult = stackMalloc(builderState.triangleCount * sizeof(Gfx));
+    // worst case is a vertex load for every corner plus a draw per triangle and the end command
+    Gfx* tmpResult = stackMalloc((builderState.triangleCount * 4 + 1) * sizeof(Gfx));
     builderState.gfx = tmpResult;
 
     gfxBuilderBuildGfx(&builderState, surfaceBuilder);
@@ -4,8 +4,10 @@
 #include "../graphics/screen_clipper.h"
 #include "../physics/collision_scene.h"
 #include "../levels/static_render.h"
+#include "update_scheduler.h"
 
 #include "../util/memory.h"
+#include "../util/time.h"
 #include "../math/mathf.h"
 #include "../math/matrix.h"
 
@@ -28,6 +30,108 @@
 #define ASPECT_SD 1.333333333333333    //  4:3
 #define ASPECT_WIDE 1.777777777777778  // 16:9
 
+// the portal depth is cut when the average graphics task time goes
+// over the frame budget and is only raised again after a long stretch
+// with plenty of headroom so it doesn't flicker between depths
+#define PORTAL_DEPTH_OVER_BUDGET        1.0f
+#define PORTAL_DEPTH_UNDER_BUDGET       0.7f
+#define PORTAL_DEPTH_DROP_FRAMES        8
+#define PORTAL_DEPTH_RAISE_FRAMES       90
+#define PORTAL_DEPTH_MAX_RAISE_FRAMES   (PORTAL_DEPTH_RAISE_FRAMES * 16)
+// tasks built before a depth change are still finishing for a couple frames
+#define PORTAL_DEPTH_SETTLE_FRAMES      3
+#define PORTAL_DEPTH_AVERAGE_WEIGHT     0.125f
+
+struct PortalDepthController {
+    float averageUsec;
+    short depth;
+    short overBudgetFrames;
+    short underBudgetFrames;
+    // doubled each time a raised depth goes back over budget
+    short raiseFrames;
+    // frames since the depth was raised or -1 once the raise has held
+    short framesSinceRaise;
+    short settleFrames;
+};
+
+struct PortalDepthController gPortalDepthController = {
+    .depth = -1,
+    .raiseFrames = PORTAL_DEPTH_RAISE_FRAMES,
+    .framesSinceRaise = -1,
+};
+
+static void portalDepthControllerSetDepth(struct PortalDepthController* controller, int depth) {
+    controller->depth = depth;
+    controller->overBudgetFrames = 0;
+    controller->underBudgetFrames = 0;
+    controller->settleFrames = PORTAL_DEPTH_SETTLE_FRAMES;
+}
+
+void portalDepthControllerUpdate(struct PortalDepthController* controller) {
+    int maxDepth = gSaveData.controls.portalRenderDepth;
+
+    if (controller->depth < 0 || controller->depth > maxDepth) {
+        controller->depth = maxDepth;
+    }
+
+    if (controller->settleFrames > 0) {
+        --controller->settleFrames;
+
+        // the average from the old depth says nothing about the new one
+        if (controller->settleFrames == 0) {
+            controller->averageUsec = gGraphicsTaskUsec;
+        }
+
+        return;
+    }
+
+    controller->averageUsec += (gGraphicsTaskUsec - controller->averageUsec) * PORTAL_DEPTH_AVERAGE_WEIGHT;
+
+    if (controller->framesSinceRaise >= 0) {
+        ++controller->framesSinceRaise;
+
+        if (controller->framesSinceRaise >= PORTAL_DEPTH_RAISE_FRAMES) {
+            controller->raiseFrames = PORTAL_DEPTH_RAISE_FRAMES;
+            controller->framesSinceRaise = -1;
+        }
+    }
+
+    float budgetUsec = FIXED_DELTA_TIME * 1000000.0f;
+
+    if (controller->averageUsec > budgetUsec * PORTAL_DEPTH_OVER_BUDGET) {
+        controller->underBudgetFrames = 0;
+
+        if (controller->overBudgetFrames < PORTAL_DEPTH_DROP_FRAMES) {
+            ++controller->overBudgetFrames;
+        }
+
+        // always allow at least one level so portals can be seen through
+        if (controller->overBudgetFrames >= PORTAL_DEPTH_DROP_FRAMES && controller->depth > 1) {
+            // the last raise didn't fit so wait longer before trying it again
+            if (controller->framesSinceRaise >= 0) {
+                controller->raiseFrames = MIN(controller->raiseFrames * 2, PORTAL_DEPTH_MAX_RAISE_FRAMES);
+                controller->framesSinceRaise = -1;
+            }
+
+            portalDepthControllerSetDepth(controller, controller->depth - 1);
+        }
+    } else if (controller->averageUsec < budgetUsec * PORTAL_DEPTH_UNDER_BUDGET) {
+        controller->overBudgetFrames = 0;
+
+        if (controller->underBudgetFrames < controller->raiseFrames) {
+            ++controller->underBudgetFrames;
+        }
+
+        if (controller->underBudgetFrames >= controller->raiseFrames && controller->depth < maxDepth) {
+            controller->framesSinceRaise = 0;
+            portalDepthControllerSetDepth(controller, controller->depth + 1);
+        }
+    } else {
+        controller->overBudgetFrames = 0;
+        controller->underBudgetFrames = 0;
+    }
+}
+
 void renderPropscheckViewportSize(int* min, int* max, int screenSize) {
     if (*max < MIN_VP_WIDTH) {
         *max = MIN_VP_WIDTH;
@@ -124,6 +228,46 @@ float getAspect()
 
 #define CALC_SCREEN_SPACE(clip_space, screen_size) ((clip_space + 1.0f) * ((screen_size) / 2))
 
+// keeps the wall the portal is on from occluding the portal
+#define PORTAL_OCCLUSION_BIAS   0.1f
+
+// only checks the main camera since cameras looking through a portal
+// usually sit behind the wall of the exit portal
+int renderPlanIsPortalOccluded(struct Scene* scene, struct RenderProps* current, int portalIndex) {
+    if (current->exitPortalIndex != NO_PORTAL || (scene->player.body.flags & (RigidBodyIsTouchingPortalA << portalIndex)) != 0) {
+        return 0;
+    }
+
+    struct Portal* portal = &scene->portals[portalIndex];
+    struct Vector3* cameraPos = &current->camera.transform.position;
+    struct CollisionObject* occluder = NULL;
+
+    // collision quads are convex so if the same quad blocks every
+    // point on the outline it blocks the whole portal
+    for (int i = 0; i < PORTAL_LOOP_SIZE; ++i) {
+        struct Vector3 localPoint;
+        vector3Scale(&gPortalOutline[i], &localPoint, 1.0f / SCENE_SCALE);
+
+        struct Vector3 worldPoint;
+        transformPoint(&portal->rigidBody.transform, &localPoint, &worldPoint);
+
+        struct Vector3 offset;
+        vector3Sub(cameraPos, &worldPoint, &offset);
+        vector3Normalize(&offset, &offset);
+        vector3AddScaled(&worldPoint, &offset, PORTAL_OCCLUSION_BIAS, &worldPoint);
+
+        struct CollisionObject* pointOccluder = collisionSceneFindOccluder(&gCollisionScene, current->fromRoom, cameraPos, &worldPoint);
+
+        if (!pointOccluder || (occluder && pointOccluder != occluder)) {
+            return 0;
+        }
+
+        occluder = pointOccluder;
+    }
+
+    return 1;
+}
+
 int renderPlanPortal(struct RenderPlan* renderPlan, struct Scene* scene, struct RenderProps* current, int portalIndex, struct RenderProps** prevSiblingPtr, struct RenderState* renderState) {
     int exitPortalIndex = 1 - portalIndex;
     struct Portal* portal = &scene->portals[portalIndex];
@@ -143,7 +287,7 @@ int renderPlanPortal(struct RenderPlan* renderPlan, struct Scene* scene, struct
     if (vector3Dot(&worldForward, &offsetFromCamera) < 0.0f) {
         return 0;
     }
-    
+
     int flags = PORTAL_RENDER_TYPE_VISIBLE(portalIndex);
 
     float portalTransform[4][4];
@@ -154,6 +298,16 @@ int renderPlanPortal(struct RenderPlan* renderPlan, struct Scene* scene, struct
         return flags; 
     }
 
+    // the portal is drawn with its cover when the frame budget cut the depth
+    if (gSaveData.controls.portalRenderDepth - current->currentDepth >= gPortalDepthController.depth) {
+        return flags;
+    }
+
+    // the cover is still drawn so only the extra render stage is skipped
+    if (renderPlanIsPortalOccluded(scene, current, portalIndex)) {
+        return flags;
+    }
+
     struct RenderProps* next = &renderPlan->stageProps[renderPlan->stageCount];
 
     struct ScreenClipper clipper;
@@ -178,6 +332,10 @@ int renderPlanPortal(struct RenderPlan* renderPlan, struct Scene* scene, struct
     next->minY = MAX(next->minY, current->minY);
     next->maxY = MIN(next->maxY, current->maxY);
 
+    if (next->minX >= next->maxX || next->minY >= next->maxY) {
+        return 0;
+    }
+
     struct RenderProps* prevSibling = prevSiblingPtr ? *prevSiblingPtr : NULL;
 
     if (prevSibling) {
@@ -485,6 +643,8 @@ void renderPlanAdjustViewportDepth(struct RenderPlan* renderPlan) {
 }
 
 void renderPlanBuild(struct RenderPlan* renderPlan, struct Scene* scene, struct RenderState* renderState) {
+    portalDepthControllerUpdate(&gPortalDepthController);
+
     renderPropsInit(&renderPlan->stageProps[0], &scene->camera, getAspect(), renderState, scene->player.body.currentRoom);
     renderPlan->stageCount = 1;
     renderPlan->clippedPortalIndex = -1;
@@ -493,6 +653,14 @@ void renderPlanBuild(struct RenderPlan* renderPlan, struct Scene* scene, struct
     renderPlanFinishView(renderPlan, scene, &renderPlan->stageProps[0], renderState);
 
     renderPlanAdjustViewportDepth(renderPlan);
+
+    u64 visibleRooms = 0;
+
+    for (int i = 0; i < renderPlan->stageCount; ++i) {
+        visibleRooms |= renderPlan->stageProps[i].visiblerooms;
+    }
+
+    updateSchedulerSetVisibleRooms(visibleRooms);
 }
 
 #define MIN_FOG_DISTANCE 1.0f
@@ -26,9 +26,11 @@
 #include "../audio/clips.h"
 #include "../levels/cutscene_runner.h"
 #include "../util/memory.h"
+#include "../util/dynamic_asset_loader.h"
 #include "../decor/decor_object_list.h"
 #include "signals.h"
 #include "render_plan.h"
+#include "update_scheduler.h"
 #include "../menu/game_menu.h"
 #include "../effects/effect_definitions.h"
 #include "../controls/rumble_pak.h"
@@ -36,6 +38,7 @@
 
 #include "../build/src/audio/subtitles.h"
 #include "../build/src/audio/clips.h"
+#include "../build/assets/models/dynamic_model_list.h"
 
 extern struct GameMenu gGameMenu;
 
@@ -101,6 +104,9 @@ void sceneInit(struct Scene* scene) {
 
 void sceneInitNoPauseMenu(struct Scene* scene, int mainMenuMode) {
     signalsInit(1);
+    signalsInitOperators(gCurrentLevel->signalOperatorCount);
+    updateSchedulerWakeAll();
+    scene->residencyRoom = -1;
     rumblePakSetPaused(0);
 
     cameraInit(&scene->camera, DEFAULT_CAMERA_FOV, DEFAULT_NEAR_PLANE * SCENE_SCALE, DEFAULT_FAR_PLANE * SCENE_SCALE);
@@ -176,6 +182,8 @@ void sceneInitNoPauseMenu(struct Scene* scene, int mainMenuMode) {
         triggerOffset += gCurrentLevel->triggers[i].triggerCount;
     }
 
+    triggerIndexInit(scene->triggerListeners, scene->triggerListenerCount);
+
     scene->doorCount = gCurrentLevel->doorCount;
     scene->doors = malloc(sizeof(struct Door) * scene->doorCount);
     for (int i = 0; i < scene->doorCount; ++i) {
@@ -569,6 +577,61 @@ void sceneUpdateAnimatedObjects(struct Scene* scene) {
     }
 }
 
+void scenePrefetchRoomModels(int roomIndex) {
+    for (int i = 0; i < gCurrentLevel->decorCount; ++i) {
+        struct DecorDefinition* decorDef = &gCurrentLevel->decor[i];
+        struct DecorObjectDefinition* objectDef = decorObjectDefinitionForId(decorDef->decorId);
+
+        if (decorDef->roomIndex == roomIndex && objectDef) {
+            dynamicAssetModelPrefetch(objectDef->dynamicModelIndex);
+        }
+    }
+
+    for (int i = 0; i < gCurrentLevel->fizzlerCount; ++i) {
+        if (gCurrentLevel->fizzlers[i].roomIndex == roomIndex) {
+            dynamicAssetModelPrefetch(PROPS_PORTAL_CLEANSER_DYNAMIC_MODEL);
+        }
+    }
+
+    for (int i = 0; i < gCurrentLevel->boxDropperCount; ++i) {
+        if (gCurrentLevel->boxDroppers[i].roomIndex == roomIndex) {
+            dynamicAssetModelPrefetch(CUBE_CUBE_DYNAMIC_MODEL);
+            dynamicAssetModelPrefetch(PROPS_BOX_DROPPER_GLASS_DYNAMIC_MODEL);
+        }
+    }
+
+    for (int i = 0; i < gCurrentLevel->clockCount; ++i) {
+        if (gCurrentLevel->clocks[i].roomIndex == roomIndex) {
+            dynamicAssetModelPrefetch(SIGNAGE_CLOCK_DYNAMIC_MODEL);
+            dynamicAssetModelPrefetch(SIGNAGE_CLOCK_DIGITS_DYNAMIC_MODEL);
+        }
+    }
+}
+
+// keeps the models for rooms next to the player loaded
+// so walking through a doorway doesn't cause a load hitch
+void sceneUpdateModelResidency(struct Scene* scene) {
+    int currentRoom = scene->player.body.currentRoom;
+
+    if (currentRoom == scene->residencyRoom) {
+        return;
+    }
+
+    scene->residencyRoom = currentRoom;
+
+    struct World* world = &gCurrentLevel->world;
+
+    for (int i = 0; i < world->doorwayCount; ++i) {
+        struct Doorway* doorway = &world->doorways[i];
+
+        if (doorway->roomA == currentRoom) {
+            scenePrefetchRoomModels(doorway->roomB);
+        } else if (doorway->roomB == currentRoom) {
+            scenePrefetchRoomModels(doorway->roomA);
+        }
+    }
+}
+
 void sceneUpdate(struct Scene* scene) {
     scene->boolCutsceneIsRunning = cutsceneIsSoundQueued();
 
@@ -620,7 +683,10 @@ void sceneUpdate(struct Scene* scene) {
         scene->player.flags &= ~PlayerInCutscene;
     }
 
+    updateSchedulerBeginFrame();
+
     // objects that can fizzle need to update before the player
+    OSTime decorStartTime = updateSchedulerTimeStart();
     int decorWriteIndex = 0;
 
     for (int i = 0; i < scene->decorCount; ++i) {
@@ -637,16 +703,13 @@ void sceneUpdate(struct Scene* scene) {
     }
 
     scene->decorCount = decorWriteIndex;
+    updateSchedulerTimeEnd(UpdateTypeDecor, decorStartTime, decorWriteIndex);
 
-    for (int i = 0; i < scene->clockCount; ++i) {
-        clockUpdate(&scene->clocks[i]);
-    }
-
-    for (int i = 0; i < scene->securityCameraCount; ++i) {
-        securityCameraUpdate(&scene->securityCameras[i]);
-    }
+    updateSchedulerRun(UpdateTypeClock, scene->clocks, scene->clockCount);
+    updateSchedulerRun(UpdateTypeSecurityCamera, scene->securityCameras, scene->securityCameraCount);
 
     playerUpdate(&scene->player);
+    sceneUpdateModelResidency(scene);
     portalGunUpdate(&scene->portalGun, &scene->player);
     sceneUpdateListeners(scene);
     sceneCheckPortals(scene);
@@ -662,32 +725,25 @@ void sceneUpdate(struct Scene* scene) {
         levelLoadLastCheckpoint();
     }
     
-    for (int i = 0; i < scene->buttonCount; ++i) {
-        buttonUpdate(&scene->buttons[i]);
-    }
-
-    for (int i = 0; i < scene->switchCount; ++i) {
-        switchUpdate(&scene->switches[i]);
-    }
+    updateSchedulerRun(UpdateTypeButton, scene->buttons, scene->buttonCount);
+    updateSchedulerRun(UpdateTypeSwitch, scene->switches, scene->switchCount);
 
+    OSTime ballCatcherStartTime = updateSchedulerTimeStart();
     for (int i = 0; i < scene->ballCatcherCount; ++i) {
         ballCatcherUpdate(&scene->ballCatchers[i], scene->ballLaunchers, scene->ballLancherCount);
     }
+    updateSchedulerTimeEnd(UpdateTypeBallCatcher, ballCatcherStartTime, scene->ballCatcherCount);
 
-    for (int i = 0; i < scene->triggerListenerCount; ++i) {
-        triggerListenerUpdate(&scene->triggerListeners[i]);
-    }
+    OSTime triggerStartTime = updateSchedulerTimeStart();
+    int activeTriggers = triggerIndexUpdate();
+    updateSchedulerTimeEnd(UpdateTypeTriggerListener, triggerStartTime, activeTriggers);
     
     signalsEvaluateSignals(gCurrentLevel->signalOperators, gCurrentLevel->signalOperatorCount);
 
-    for (int i = 0; i < scene->doorCount; ++i) {
-        doorUpdate(&scene->doors[i]);
-    }
-
-    for (int i = 0; i < scene->fizzlerCount; ++i) {
-        fizzlerUpdate(&scene->fizzlers[i]);
-    }
+    updateSchedulerRun(UpdateTypeDoor, scene->doors, scene->doorCount);
+    updateSchedulerRun(UpdateTypeFizzler, scene->fizzlers, scene->fizzlerCount);
     
+    OSTime elevatorStartTime = updateSchedulerTimeStart();
     for (int i = 0; i < scene->elevatorCount; ++i) {
         int teleportTo = elevatorUpdate(&scene->elevators[i], &scene->player);
 
@@ -722,21 +778,12 @@ void sceneUpdate(struct Scene* scene) {
         }
     }
 
-    for (int i = 0; i < scene->pedestalCount; ++i) {
-        pedestalUpdate(&scene->pedestals[i]);
-    }
+    updateSchedulerTimeEnd(UpdateTypeElevator, elevatorStartTime, scene->elevatorCount);
 
-    for (int i = 0; i < scene->signageCount; ++i) {
-        signageUpdate(&scene->signage[i]);
-    }
-
-    for (int i = 0; i < scene->boxDropperCount; ++i) {
-        boxDropperUpdate(&scene->boxDroppers[i]);
-    }
-
-    for (int i = 0; i < scene->ballLancherCount; ++i) {
-        ballLauncherUpdate(&scene->ballLaunchers[i]);
-    }
+    updateSchedulerRun(UpdateTypePedestal, scene->pedestals, scene->pedestalCount);
+    updateSchedulerRun(UpdateTypeSignage, scene->signage, scene->signageCount);
+    updateSchedulerRun(UpdateTypeBoxDropper, scene->boxDroppers, scene->boxDropperCount);
+    updateSchedulerRun(UpdateTypeBallLauncher, scene->ballLaunchers, scene->ballLancherCount);
 
     sceneAnimatorUpdate(&scene->animator);
     sceneUpdatePortalVelocity(scene);
@@ -747,6 +794,7 @@ void sceneUpdate(struct Scene* scene) {
     collisionSceneUpdateDynamics();
 
     cutscenesUpdate();
+    updateSchedulerEndFrame();
 
     scene->cpuTime = osGetTime() - frameStart;
     scene->lastFrameStart = frameStart;
@@ -84,6 +84,9 @@ struct Scene {
     u8 securityCameraCount;
     u8 boolCutsceneIsRunning;
 
+    // room dynamic models were last prefetched for
+    short residencyRoom;
+
     u8 continuouslyAttemptingPortalOpen;
     u8 checkpointState;
     u8 ignorePortalGun;
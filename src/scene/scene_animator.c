@@ -46,7 +46,6 @@ void sceneAnimatorInit(struct SceneAnimator* sceneAnimator, struct AnimationInfo
         sceneAnimator->state[i].playbackSpeed = 1.0f;
         sceneAnimator->state[i].soundId = SOUND_ID_NONE;
         sceneAnimator->state[i].flags = 0;
-        vector3Scale(&sceneAnimator->armatures[i].pose[0].position, &sceneAnimator->state[i].lastPosition, 1.0f / SCENE_SCALE);
 
         pose += animationInfo[i].armature.numberOfBones;
     }
@@ -55,16 +54,21 @@ void sceneAnimatorInit(struct SceneAnimator* sceneAnimator, struct AnimationInfo
 void sceneAnimatorUpdate(struct SceneAnimator* sceneAnimator) {
     for (int i = 0; i < sceneAnimator->animatorCount; ++i) {
         struct SceneAnimatorState* state = &sceneAnimator->state[i];
+        struct SKAnimator* animator = &sceneAnimator->animators[i];
 
-        skAnimatorUpdate(&sceneAnimator->animators[i], sceneAnimator->armatures[i].pose, FIXED_DELTA_TIME * state->playbackSpeed);
+        skAnimatorUpdate(animator, sceneAnimator->armatures[i].pose, FIXED_DELTA_TIME * state->playbackSpeed);
 
         struct AnimatedAudioInfo* audioInfo = &gAnimatedAudioInfo[sceneAnimator->animationInfo[i].soundType];
 
+        int isMoving = skAnimatorIsRunning(animator) && !skAnimatorIsHolding(animator) && state->playbackSpeed != 0.0f;
+        int wasMoving = (state->flags & SceneAnimatorStateWasMoving) != 0;
+
+        if (!isMoving && !wasMoving) {
+            continue;
+        }
 
         struct Vector3 currentPos;
         vector3Scale(&sceneAnimator->armatures[i].pose[0].position, &currentPos, 1.0f / SCENE_SCALE);
-        int isMoving = currentPos.x != state->lastPosition.x || currentPos.y != state->lastPosition.y || currentPos.z != state->lastPosition.z;
-        int wasMoving = (state->flags & SceneAnimatorStateWasMoving) != 0;
 
         if (audioInfo->loopSoundId != SOUND_ID_NONE) {
             if (isMoving && state->soundId == SOUND_ID_NONE) {
@@ -85,7 +89,6 @@ void sceneAnimatorUpdate(struct SceneAnimator* sceneAnimator) {
             soundPlayerPlay(audioInfo->endSoundId, 1.0f, audioInfo->pitch, &currentPos, &gZeroVec, SoundTypeAll);
         }
 
-        state->lastPosition = currentPos;
         state->flags &= ~SceneAnimatorStateWasMoving;
         if (isMoving) {
             state->flags |= SceneAnimatorStateWasMoving;
@@ -16,7 +16,6 @@ struct SceneAnimatorState {
     float playbackSpeed;
     ALSndId soundId;
     short flags;
-    struct Vector3 lastPosition;
 };
 
 struct SceneAnimator {
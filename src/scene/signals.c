@@ -2,12 +2,25 @@
 #include "signals.h"
 
 #include "../util/memory.h"
+#include "../util/time.h"
 
 unsigned long long* gSignals;
 unsigned long long* gPrevSignals;
 unsigned long long* gDefaultSignals;
 unsigned gSignalCount;
 
+#define SIGNAL_OPERATOR_SENT    (1 << 0)
+
+struct SignalOperatorState {
+    float timer;
+    unsigned char flags;
+};
+
+struct SignalOperatorState* gSignalOperatorStates;
+unsigned gSignalOperatorCount;
+// set when the cached operator results can't be trusted
+char gSignalOperatorsDirty;
+
 #define DETERMINE_BIN_AND_MASK(bin, mask, signalIndex) do { bin = (signalIndex) >> 6; mask = 1LL << ((signalIndex) & 63); } while (0)
 
 void signalsInit(unsigned signalCount) {
@@ -28,6 +41,23 @@ void signalsInit(unsigned signalCount) {
     }
 }
 
+void signalsInitOperators(unsigned operatorCount) {
+    gSignalOperatorCount = operatorCount;
+    gSignalOperatorsDirty = 1;
+
+    if (!operatorCount) {
+        gSignalOperatorStates = NULL;
+        return;
+    }
+
+    gSignalOperatorStates = malloc(sizeof(struct SignalOperatorState) * operatorCount);
+
+    for (unsigned i = 0; i < operatorCount; ++i) {
+        gSignalOperatorStates[i].timer = 0.0f;
+        gSignalOperatorStates[i].flags = 0;
+    }
+}
+
 void signalsReset() {
     int binCount = (gSignalCount + 63) >> 6;
 
@@ -63,6 +93,27 @@ int signalsReadPrevious(unsigned signalIndex) {
     return (gPrevSignals[bin] & mask) != 0;
 }
 
+int signalsChanged(unsigned signalIndex) {
+    unsigned bin;
+    unsigned long long mask;
+
+    DETERMINE_BIN_AND_MASK(bin, mask, signalIndex);
+
+    if (bin >= gSignalCount) {
+        return 0;
+    }
+
+    return ((gSignals[bin] ^ gPrevSignals[bin]) & mask) != 0;
+}
+
+unsigned long long signalsChangedMask(unsigned bin) {
+    if (bin >= gSignalCount) {
+        return 0;
+    }
+
+    return gSignals[bin] ^ gPrevSignals[bin];
+}
+
 int signalCount() {
     return gSignalCount;
 }
@@ -93,36 +144,94 @@ void signalsSetDefault(unsigned signalIndex, int value) {
     gDefaultSignals[bin] = (gDefaultSignals[bin] & ~mask) | (value ? mask : 0);
 }
 
-void signalsEvaluateSignal(struct SignalOperator* operator) {
+int signalsEvaluateSignal(struct SignalOperator* operator) {
     switch (operator->type) {
         case SignalOperatorTypeAnd:
-            if (signalsRead(operator->inputSignals[0]) && signalsRead(operator->inputSignals[1])) {
-                signalsSend(operator->outputSignal);
-            }
-            break;
+            return signalsRead(operator->inputSignals[0]) && signalsRead(operator->inputSignals[1]);
         case SignalOperatorTypeOr:
-            if (signalsRead(operator->inputSignals[0]) || signalsRead(operator->inputSignals[1])) {
-                signalsSend(operator->outputSignal);
-            }
-            break;
+            return signalsRead(operator->inputSignals[0]) || signalsRead(operator->inputSignals[1]);
         case SignalOperatorTypeNot:
-            if (!signalsRead(operator->inputSignals[0])) {
-                signalsSend(operator->outputSignal);
-            }
-            break;
-        case SignalOperatorTypeTimer:
-            break;
+            return !signalsRead(operator->inputSignals[0]);
+    }
+
+    return 0;
+}
+
+int signalsInputsChanged(struct SignalOperator* operator) {
+    if (signalsChanged(operator->inputSignals[0])) {
+        return 1;
+    }
+
+    return operator->type != SignalOperatorTypeNot && operator->type != SignalOperatorTypeTimer && signalsChanged(operator->inputSignals[1]);
+}
+
+void signalsEvaluateTimer(struct SignalOperator* operator, struct SignalOperatorState* state) {
+    // restart on the frame the input turns on
+    if (signalsChanged(operator->inputSignals[0]) && signalsRead(operator->inputSignals[0])) {
+        state->timer = operator->data.duration * (1.0f / SIGNAL_TIMER_TICKS_PER_SECOND);
+    }
+
+    if (state->timer > 0.0f) {
+        state->timer -= FIXED_DELTA_TIME;
+        signalsSend(operator->outputSignal);
     }
 }
 
 void signalsEvaluateSignals(struct SignalOperator* operator, unsigned count) {
+    if (count > gSignalOperatorCount) {
+        // no cached state to work with
+        for (unsigned i = 0; i < count; ++i) {
+            if (operator[i].type != SignalOperatorTypeTimer && signalsEvaluateSignal(&operator[i])) {
+                signalsSend(operator[i].outputSignal);
+            }
+        }
+        return;
+    }
+
+    // the operators are sorted so each input is final by the time it
+    // is read. An operator whose inputs match last frame gives the same
+    // result as last frame so only operators downstream of a change
+    // are evaluated again
     for (unsigned i = 0; i < count; ++i) {
-        signalsEvaluateSignal(&operator[i]);
+        struct SignalOperator* current = &operator[i];
+        struct SignalOperatorState* state = &gSignalOperatorStates[i];
+
+        if (current->type == SignalOperatorTypeTimer) {
+            signalsEvaluateTimer(current, state);
+            continue;
+        }
+
+        if (gSignalOperatorsDirty || signalsInputsChanged(current)) {
+            state->flags = signalsEvaluateSignal(current) ? SIGNAL_OPERATOR_SENT : 0;
+        }
+
+        if (state->flags & SIGNAL_OPERATOR_SENT) {
+            signalsSend(current->outputSignal);
+        }
+    }
+
+    gSignalOperatorsDirty = 0;
+}
+
+// only the bytes that hold signals are written instead of whole bins
+void signalsSerializeBits(struct Serializer* serializer, SerializeAction action, unsigned long long* bins) {
+    int byteCount = (gSignalCount + 7) >> 3;
+
+    for (int i = 0; i < byteCount; ++i) {
+        int shift = (i & 7) << 3;
+        unsigned long long* bin = &bins[i >> 3];
+        unsigned char packed = (unsigned char)(*bin >> shift);
+
+        action(serializer, &packed, sizeof(packed));
+
+        *bin = (*bin & ~(0xFFull << shift)) | ((unsigned long long)packed << shift);
     }
 }
 
 void signalsSerializeRW(struct Serializer* serializer, SerializeAction action) {
-    int binCount = SIGNAL_BIN_COUNT(gSignalCount);
-    action(serializer, gSignals, sizeof(unsigned long long) * binCount);
-    action(serializer, gDefaultSignals, sizeof(unsigned long long) * binCount);
+    signalsSerializeBits(serializer, action, gSignals);
+    signalsSerializeBits(serializer, action, gDefaultSignals);
+
+    // the previous frame no longer matches after a load
+    gSignalOperatorsDirty = 1;
 }
\ No newline at end of file
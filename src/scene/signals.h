@@ -12,20 +12,28 @@ enum SignalOperatorType {
     SignalOperatorTypeTimer,
 };
 
+#define SIGNAL_TIMER_TICKS_PER_SECOND   100
+
 struct SignalOperator {
     unsigned char type;
     unsigned char outputSignal;
     unsigned char inputSignals[2];
     union {
         char additionalInputs[2];
+        // in SIGNAL_TIMER_TICKS_PER_SECOND, the output stays on
+        // for this long after the input turns on
         short duration;
     } data;
 };
 
 void signalsInit(unsigned signalCount);
+// operators are expected to be sorted so inputs are written before they are read
+void signalsInitOperators(unsigned operatorCount);
 void signalsReset();
 int signalsRead(unsigned signalIndex);
 int signalsReadPrevious(unsigned signalIndex);
+// bit n is set if signal (bin * 64 + n) changed since the last frame
+unsigned long long signalsChangedMask(unsigned bin);
 int signalCount();
 void signalsSend(unsigned signalIndex);
 void signalsSetDefault(unsigned signalIndex, int value);
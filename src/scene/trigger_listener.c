@@ -3,6 +3,9 @@
 #include "../physics/collision_scene.h"
 #include "../decor/decor_object_list.h"
 #include "../levels/cutscene_runner.h"
+#include "../levels/levels.h"
+#include "../math/range.h"
+#include "../util/memory.h"
 
 #include "./scene.h"
 
@@ -10,6 +13,31 @@ extern struct ColliderTypeData gPlayerColliderData;
 
 #define TRIGGER_TYPE_TO_MASK(type)      (1 << (type))
 
+struct TriggerOccupant {
+    struct CollisionObject* object;
+    struct Vector3 lastPosition;
+    short lastRoom;
+    short typeMask;
+    short insideCount;
+    u16 inside[TRIGGER_MAX_OVERLAPS];
+};
+
+struct TriggerIndex {
+    struct TriggerListener* listeners;
+    // listener indices grouped by room and sorted by min x
+    u16* roomListeners;
+    struct Rangeu16* roomRanges;
+    u16* activeListeners;
+    short activeCount;
+    short roomCount;
+
+    struct TriggerOccupant occupants[2][MAX_DYNAMIC_OBJECTS];
+    short occupantCount;
+    short currentOccupants;
+};
+
+struct TriggerIndex gTriggerIndex;
+
 enum ObjectTriggerType triggerDetermineType(struct CollisionObject* objectEnteringTrigger) {
     if (objectEnteringTrigger->collider == &gPlayerColliderData) {
         return TRIGGER_TYPE_TO_MASK(ObjectTriggerTypePlayer);
@@ -24,84 +52,242 @@ enum ObjectTriggerType triggerDetermineType(struct CollisionObject* objectEnteri
     return ObjectTriggerTypeNone;
 }
 
-void triggerTrigger(void* data, struct CollisionObject* objectEnteringTrigger) {
-    struct TriggerListener* listener = data;
+void triggerInit(struct TriggerListener* listener, struct Trigger* trigger, int triggerIndex) {
+    listener->trigger = trigger;
+    listener->triggerIndex = triggerIndex;
+    listener->occupiedMask = 0;
+    listener->usedTriggerMask = 0;
+    listener->activeIndex = -1;
 
-    struct Vector3 offset;
-    vector3Sub(
-        &objectEnteringTrigger->body->transform.position, 
-        &listener->body.transform.position, 
-        &offset
-    );
+    for (int i = 0; i < TRIGGER_TYPE_COUNT; ++i) {
+        listener->occupantCount[i] = 0;
+    }
 
-    if (fabsf(offset.x) > listener->collisionData.sideLength.x ||
-        fabsf(offset.y) > listener->collisionData.sideLength.y ||
-        fabsf(offset.z) > listener->collisionData.sideLength.z) {
-        // only trigger when triggering object is contained
+    for (int i = 0; i < trigger->triggerCount; ++i) {
+        struct ObjectTriggerInfo* triggerInfo = &trigger->triggers[i];
+        listener->usedTriggerMask |= 1 << triggerInfo->objectType;
+    }
+}
+
+void triggerListenerUpdate(struct TriggerListener* listener) {
+    if (!(listener->occupiedMask & listener->usedTriggerMask)) {
         return;
     }
 
-    enum ObjectTriggerType triggerType = triggerDetermineType(objectEnteringTrigger);
+    struct Trigger* trigger = listener->trigger;
+
+    for (int i = 0; i < trigger->triggerCount; ++i) {
+        struct ObjectTriggerInfo* triggerInfo = &trigger->triggers[i];
+
+        if ((1 << triggerInfo->objectType) & listener->occupiedMask) {
+            if (triggerInfo->signalIndex != -1) {
+                signalsSend(triggerInfo->signalIndex);
+            }
+
+            cutsceneTrigger(triggerInfo->cutsceneIndex, listener->triggerIndex + i);
+        }
+    }
+}
+
+void triggerIndexInit(struct TriggerListener* listeners, int listenerCount) {
+    struct World* world = &gCurrentLevel->world;
+
+    gTriggerIndex.listeners = listeners;
+    gTriggerIndex.roomCount = world->roomCount;
+    gTriggerIndex.roomRanges = malloc(sizeof(struct Rangeu16) * world->roomCount);
+    gTriggerIndex.activeListeners = malloc(sizeof(u16) * listenerCount);
+    gTriggerIndex.activeCount = 0;
+    gTriggerIndex.occupantCount = 0;
+    gTriggerIndex.currentOccupants = 0;
+
+    int totalEntries = 0;
 
-    if (triggerType & listener->usedTriggerMask) {
-        // an object activating a signal should not sleep
-        objectEnteringTrigger->body->sleepFrames = IDLE_SLEEP_FRAMES;
+    for (int roomIndex = 0; roomIndex < world->roomCount; ++roomIndex) {
+        for (int i = 0; i < listenerCount; ++i) {
+            if (box3DHasOverlap(&listeners[i].trigger->box, &world->rooms[roomIndex].boundingBox)) {
+                ++totalEntries;
+            }
+        }
     }
 
-    listener->lastTriggerMask |= triggerType;
+    gTriggerIndex.roomListeners = malloc(sizeof(u16) * totalEntries);
+
+    int entry = 0;
+
+    for (int roomIndex = 0; roomIndex < world->roomCount; ++roomIndex) {
+        struct Rangeu16* range = &gTriggerIndex.roomRanges[roomIndex];
+        range->min = entry;
+
+        for (int i = 0; i < listenerCount; ++i) {
+            if (!box3DHasOverlap(&listeners[i].trigger->box, &world->rooms[roomIndex].boundingBox)) {
+                continue;
+            }
+
+            // insertion sort, there are only ever a handful per room
+            int insertAt = entry;
+
+            while (insertAt > range->min &&
+                listeners[gTriggerIndex.roomListeners[insertAt - 1]].trigger->box.min.x > listeners[i].trigger->box.min.x) {
+                gTriggerIndex.roomListeners[insertAt] = gTriggerIndex.roomListeners[insertAt - 1];
+                --insertAt;
+            }
+
+            gTriggerIndex.roomListeners[insertAt] = i;
+            ++entry;
+        }
+
+        range->max = entry;
+    }
 }
 
-void triggerInit(struct TriggerListener* listener, struct Trigger* trigger, int triggerIndex) {
-    vector3Sub(&trigger->box.max, &trigger->box.min, &listener->collisionData.sideLength);
-    vector3Scale(&listener->collisionData.sideLength, &listener->collisionData.sideLength, 0.5f);
+static void triggerIndexSetOccupants(struct TriggerListener* listener, int typeMask, int direction) {
+    int wasActive = (listener->occupiedMask & listener->usedTriggerMask) != 0;
 
-    listener->colliderType.type = CollisionShapeTypeBox;
-    listener->colliderType.data = &listener->collisionData; 
-    listener->colliderType.bounce = 0.0f;
-    listener->colliderType.friction = 0.0f;
-    listener->colliderType.callbacks = &gCollisionBoxCallbacks;
+    for (int type = 0; type < TRIGGER_TYPE_COUNT; ++type) {
+        if (!(typeMask & TRIGGER_TYPE_TO_MASK(type))) {
+            continue;
+        }
 
-    collisionObjectInit(&listener->collisionObject, &listener->colliderType, &listener->body, 1.0f, COLLISION_LAYERS_TANGIBLE);
-    rigidBodyMarkKinematic(&listener->body);
+        listener->occupantCount[type] += direction;
 
-    vector3Add(&trigger->box.max, &trigger->box.min, &listener->body.transform.position);
-    vector3Scale(&listener->body.transform.position, &listener->body.transform.position, 0.5f);
-    collisionObjectUpdateBB(&listener->collisionObject);
+        if (listener->occupantCount[type]) {
+            listener->occupiedMask |= TRIGGER_TYPE_TO_MASK(type);
+        } else {
+            listener->occupiedMask &= ~TRIGGER_TYPE_TO_MASK(type);
+        }
+    }
 
-    listener->collisionObject.trigger = triggerTrigger;
-    listener->collisionObject.data = listener;
-    listener->trigger = trigger;
-    listener->triggerIndex = triggerIndex;
-    
-    collisionSceneAddDynamicObject(&listener->collisionObject);
+    int isActive = (listener->occupiedMask & listener->usedTriggerMask) != 0;
 
-    listener->lastTriggerMask = 0;
-    listener->usedTriggerMask = 0;
+    if (isActive && !wasActive) {
+        listener->activeIndex = gTriggerIndex.activeCount;
+        gTriggerIndex.activeListeners[gTriggerIndex.activeCount] = listener - gTriggerIndex.listeners;
+        ++gTriggerIndex.activeCount;
+    } else if (!isActive && wasActive) {
+        --gTriggerIndex.activeCount;
+        int lastListener = gTriggerIndex.activeListeners[gTriggerIndex.activeCount];
+        gTriggerIndex.activeListeners[listener->activeIndex] = lastListener;
+        gTriggerIndex.listeners[lastListener].activeIndex = listener->activeIndex;
+        listener->activeIndex = -1;
+    }
+}
 
-    for (int i = 0; i < trigger->triggerCount; ++i) {
-        struct ObjectTriggerInfo* triggerInfo = &trigger->triggers[i];
-        listener->usedTriggerMask |= 1 << triggerInfo->objectType;
+static void triggerIndexEnterAll(struct TriggerOccupant* occupant) {
+    for (int i = 0; i < occupant->insideCount; ++i) {
+        triggerIndexSetOccupants(&gTriggerIndex.listeners[occupant->inside[i]], occupant->typeMask, 1);
     }
 }
 
-void triggerListenerUpdate(struct TriggerListener* listener) {
-    if (!(listener->lastTriggerMask & listener->usedTriggerMask)) {
+static void triggerIndexExitAll(struct TriggerOccupant* occupant) {
+    for (int i = 0; i < occupant->insideCount; ++i) {
+        triggerIndexSetOccupants(&gTriggerIndex.listeners[occupant->inside[i]], occupant->typeMask, -1);
+    }
+}
+
+static void triggerIndexQuery(struct TriggerOccupant* occupant) {
+    occupant->insideCount = 0;
+
+    if (occupant->lastRoom < 0 || occupant->lastRoom >= gTriggerIndex.roomCount) {
         return;
     }
 
-    struct Trigger* trigger = listener->trigger;
+    struct Vector3* position = &occupant->lastPosition;
+    struct Rangeu16* range = &gTriggerIndex.roomRanges[occupant->lastRoom];
 
-    for (int i = 0; i < trigger->triggerCount; ++i) {
-        struct ObjectTriggerInfo* triggerInfo = &trigger->triggers[i];
+    for (int i = range->min; i < range->max; ++i) {
+        int listenerIndex = gTriggerIndex.roomListeners[i];
+        struct TriggerListener* listener = &gTriggerIndex.listeners[listenerIndex];
 
-        if ((1 << triggerInfo->objectType) & listener->lastTriggerMask) {
-            if (triggerInfo->signalIndex != -1) {
-                signalsSend(triggerInfo->signalIndex);
+        if (listener->trigger->box.min.x > position->x) {
+            break;
+        }
+
+        if (!(listener->usedTriggerMask & occupant->typeMask) || !box3DContainsPoint(&listener->trigger->box, position)) {
+            continue;
+        }
+
+        if (occupant->insideCount < TRIGGER_MAX_OVERLAPS) {
+            occupant->inside[occupant->insideCount] = listenerIndex;
+            ++occupant->insideCount;
+        }
+    }
+}
+
+static struct TriggerOccupant* triggerIndexFindPrevious(struct TriggerOccupant* previous, int previousCount, struct CollisionObject* object) {
+    for (int i = 0; i < previousCount; ++i) {
+        if (previous[i].object == object) {
+            return &previous[i];
+        }
+    }
+
+    return NULL;
+}
+
+int triggerIndexUpdate() {
+    struct TriggerOccupant* previous = gTriggerIndex.occupants[gTriggerIndex.currentOccupants];
+    struct TriggerOccupant* current = gTriggerIndex.occupants[gTriggerIndex.currentOccupants ^ 1];
+    int previousCount = gTriggerIndex.occupantCount;
+    int currentCount = 0;
+
+    for (unsigned i = 0; i < gCollisionScene.dynamicObjectCount; ++i) {
+        struct CollisionObject* object = gCollisionScene.dynamicObjects[i];
+
+        if (!(object->collisionLayers & COLLISION_LAYERS_TANGIBLE)) {
+            continue;
+        }
+
+        int typeMask = triggerDetermineType(object);
+
+        if (!typeMask) {
+            continue;
+        }
+
+        struct TriggerOccupant* occupant = &current[currentCount];
+        ++currentCount;
+
+        struct TriggerOccupant* last = triggerIndexFindPrevious(previous, previousCount, object);
+
+        if (last &&
+            last->typeMask == typeMask &&
+            last->lastRoom == object->body->currentRoom &&
+            vector3Equals(&last->lastPosition, &object->body->transform.position)) {
+            *occupant = *last;
+            last->object = NULL;
+        } else {
+            occupant->object = object;
+            occupant->lastPosition = object->body->transform.position;
+            occupant->lastRoom = object->body->currentRoom;
+            occupant->typeMask = typeMask;
+            triggerIndexQuery(occupant);
+
+            // enter before exit so triggers the object never left stay active
+            triggerIndexEnterAll(occupant);
+
+            if (last) {
+                triggerIndexExitAll(last);
+                last->object = NULL;
             }
+        }
 
-            cutsceneTrigger(triggerInfo->cutsceneIndex, listener->triggerIndex + i);
+        if (occupant->insideCount) {
+            // an object activating a signal should not sleep
+            object->body->sleepFrames = IDLE_SLEEP_FRAMES;
+        }
+    }
+
+    // objects that were removed from the scene
+    for (int i = 0; i < previousCount; ++i) {
+        if (previous[i].object) {
+            triggerIndexExitAll(&previous[i]);
         }
     }
 
-    listener->lastTriggerMask = 0;
-}
\ No newline at end of file
+    gTriggerIndex.currentOccupants ^= 1;
+    gTriggerIndex.occupantCount = currentCount;
+
+    for (int i = 0; i < gTriggerIndex.activeCount; ++i) {
+        triggerListenerUpdate(&gTriggerIndex.listeners[gTriggerIndex.activeListeners[i]]);
+    }
+
+    return gTriggerIndex.activeCount;
+}
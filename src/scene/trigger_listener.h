@@ -6,20 +6,27 @@
 
 #include "../levels/level_definition.h"
 
+#define TRIGGER_TYPE_COUNT      (ObjectTriggerTypeCubeHover + 1)
 
-struct TriggerListener {
-    struct CollisionObject collisionObject;
-    struct RigidBody body;
-    struct ColliderTypeData colliderType;
-    struct CollisionBox collisionData;
+// how many triggers a single object can be inside of at once
+#define TRIGGER_MAX_OVERLAPS    8
 
+struct TriggerListener {
     struct Trigger* trigger;
     short triggerIndex;
-    short lastTriggerMask;
+    short occupiedMask;
     short usedTriggerMask;
+    short activeIndex;
+    u8 occupantCount[TRIGGER_TYPE_COUNT];
 };
 
 void triggerInit(struct TriggerListener* listener, struct Trigger* trigger, int triggerIndex);
 void triggerListenerUpdate(struct TriggerListener* listener);
 
-#endif
\ No newline at end of file
+// buckets the triggers by room and sorts each bucket by min x
+void triggerIndexInit(struct TriggerListener* listeners, int listenerCount);
+// checks any object that moved against the trigger index and updates
+// the listeners that are currently occupied. returns how many were updated
+int triggerIndexUpdate();
+
+#endif
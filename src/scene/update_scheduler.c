@@ -0,0 +1,104 @@
+#include "update_scheduler.h"
+
+#include "../levels/levels.h"
+
+#include "clock.h"
+#include "security_camera.h"
+#include "button.h"
+#include "switch.h"
+#include "door.h"
+#include "fizzler.h"
+#include "pedestal.h"
+#include "signage.h"
+#include "box_dropper.h"
+#include "ball_launcher.h"
+
+// buttons and switches resend their signals every frame so they can
+// never sleep. trigger listeners are updated by the trigger index
+struct UpdateTypeDefinition gUpdateTypeDefinitions[UpdateTypeCount] = {
+    [UpdateTypeClock] = {(UpdateCallback)clockUpdate, NULL, sizeof(struct Clock)},
+    [UpdateTypeSecurityCamera] = {(UpdateCallback)securityCameraUpdate, NULL, sizeof(struct SecurityCamera)},
+    [UpdateTypeButton] = {(UpdateCallback)buttonUpdate, NULL, sizeof(struct Button)},
+    [UpdateTypeSwitch] = {(UpdateCallback)switchUpdate, NULL, sizeof(struct Switch)},
+    [UpdateTypeDoor] = {(UpdateCallback)doorUpdate, (UpdateIsAwake)doorIsAwake, sizeof(struct Door)},
+    [UpdateTypeFizzler] = {(UpdateCallback)fizzlerUpdate, (UpdateIsAwake)fizzlerIsAwake, sizeof(struct Fizzler)},
+    [UpdateTypePedestal] = {(UpdateCallback)pedestalUpdate, (UpdateIsAwake)pedestalIsAwake, sizeof(struct Pedestal)},
+    [UpdateTypeSignage] = {(UpdateCallback)signageUpdate, NULL, sizeof(struct Signage)},
+    [UpdateTypeBoxDropper] = {(UpdateCallback)boxDropperUpdate, (UpdateIsAwake)boxDropperIsAwake, sizeof(struct BoxDropper)},
+    [UpdateTypeBallLauncher] = {(UpdateCallback)ballLauncherUpdate, (UpdateIsAwake)ballLauncherIsAwake, sizeof(struct BallLauncher)},
+};
+
+struct UpdateTypeStats gUpdateStats[UpdateTypeCount];
+
+struct UpdateScheduler {
+    u64 activeRooms;
+    short wakeAll;
+};
+
+struct UpdateScheduler gUpdateScheduler;
+
+void updateSchedulerWakeAll() {
+    gUpdateScheduler.wakeAll = 1;
+}
+
+void updateSchedulerSetVisibleRooms(u64 visibleRooms) {
+    u64 activeRooms = visibleRooms;
+    struct World* world = &gCurrentLevel->world;
+
+    for (int i = 0; i < world->doorwayCount; ++i) {
+        struct Doorway* doorway = &world->doorways[i];
+
+        if (visibleRooms & (1LL << doorway->roomA)) {
+            activeRooms |= 1LL << doorway->roomB;
+        }
+
+        if (visibleRooms & (1LL << doorway->roomB)) {
+            activeRooms |= 1LL << doorway->roomA;
+        }
+    }
+
+    gUpdateScheduler.activeRooms = activeRooms;
+}
+
+int updateSchedulerIsRoomActive(int roomIndex) {
+    return gUpdateScheduler.wakeAll || (gUpdateScheduler.activeRooms & (1LL << roomIndex)) != 0;
+}
+
+void updateSchedulerBeginFrame() {
+    for (int i = 0; i < UpdateTypeCount; ++i) {
+        gUpdateStats[i].usec = 0;
+        gUpdateStats[i].updated = 0;
+        gUpdateStats[i].skipped = 0;
+    }
+}
+
+void updateSchedulerRun(enum UpdateType type, void* entities, int count) {
+    struct UpdateTypeDefinition* definition = &gUpdateTypeDefinitions[type];
+    struct UpdateTypeStats* stats = &gUpdateStats[type];
+    OSTime startTime = osGetTime();
+
+    char* entity = entities;
+    UpdateIsAwake isAwake = gUpdateScheduler.wakeAll ? NULL : definition->isAwake;
+
+    for (int i = 0; i < count; ++i) {
+        if (isAwake && !isAwake(entity)) {
+            ++stats->skipped;
+        } else {
+            definition->update(entity);
+            ++stats->updated;
+        }
+
+        entity += definition->entitySize;
+    }
+
+    stats->usec += OS_CYCLES_TO_USEC(osGetTime() - startTime);
+}
+
+void updateSchedulerTimeEnd(enum UpdateType type, OSTime startTime, int count) {
+    gUpdateStats[type].usec += OS_CYCLES_TO_USEC(osGetTime() - startTime);
+    gUpdateStats[type].updated += count;
+}
+
+void updateSchedulerEndFrame() {
+    gUpdateScheduler.wakeAll = 0;
+}
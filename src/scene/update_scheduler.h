@@ -0,0 +1,61 @@
+#ifndef __SCENE_UPDATE_SCHEDULER_H__
+#define __SCENE_UPDATE_SCHEDULER_H__
+
+#include <ultra64.h>
+
+enum UpdateType {
+    UpdateTypeDecor,
+    UpdateTypeClock,
+    UpdateTypeSecurityCamera,
+    UpdateTypeButton,
+    UpdateTypeSwitch,
+    UpdateTypeBallCatcher,
+    UpdateTypeTriggerListener,
+    UpdateTypeDoor,
+    UpdateTypeFizzler,
+    UpdateTypeElevator,
+    UpdateTypePedestal,
+    UpdateTypeSignage,
+    UpdateTypeBoxDropper,
+    UpdateTypeBallLauncher,
+    UpdateTypeCount,
+};
+
+typedef void (*UpdateCallback)(void* entity);
+// returns non zero if the entity has something to do this frame
+typedef int (*UpdateIsAwake)(void* entity);
+
+struct UpdateTypeDefinition {
+    UpdateCallback update;
+    // NULL means the entity never sleeps
+    UpdateIsAwake isAwake;
+    short entitySize;
+};
+
+struct UpdateTypeStats {
+    u32 usec;
+    short updated;
+    short skipped;
+};
+
+// stats for the most recent frame, indexed by enum UpdateType
+extern struct UpdateTypeStats gUpdateStats[UpdateTypeCount];
+
+// forces every entity to update on the next frame
+void updateSchedulerWakeAll();
+
+// rooms seen by the last render plan. Rooms connected to a visible
+// room by a doorway are also treated as active
+void updateSchedulerSetVisibleRooms(u64 visibleRooms);
+int updateSchedulerIsRoomActive(int roomIndex);
+
+void updateSchedulerBeginFrame();
+void updateSchedulerRun(enum UpdateType type, void* entities, int count);
+void updateSchedulerEndFrame();
+
+// for entities that need extra arguments or handle a result and
+// are updated directly by the scene
+#define updateSchedulerTimeStart() osGetTime()
+void updateSchedulerTimeEnd(enum UpdateType type, OSTime startTime, int count);
+
+#endif
@@ -59,6 +59,8 @@ void skAnimatorInit(struct SKAnimator* animator, int nBones) {
     animator->boneStateFrames[1] = -1;
     animator->nextFrameStateIndex = -1;
     animator->nBones = nBones;
+    animator->holdIndex = -1;
+    animator->poseHoldIndex = -1;
 }
 
 void skAnimatorCleanup(struct SKAnimator* animator) {
@@ -185,6 +187,31 @@ int skAnimatorBoneStateIndexOfFrame(struct SKAnimator* animator, int frame) {
     return -1;
 }
 
+int skAnimatorFindHold(struct SKAnimationClip* clip, int prevFrame, int nextFrame) {
+    int minFrame = MIN(prevFrame, nextFrame);
+    int maxFrame = MAX(prevFrame, nextFrame);
+
+    for (int i = 0; i < clip->nHolds; ++i) {
+        struct SKAnimationHoldRange* hold = &clip->holds[i];
+
+        if (hold->start <= minFrame && maxFrame <= hold->end) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+int skAnimatorBoneStateIndexInHold(struct SKAnimator* animator, struct SKAnimationHoldRange* hold) {
+    for (int i = 0; i < 2; ++i) {
+        if (animator->boneStateFrames[i] >= hold->start && animator->boneStateFrames[i] <= hold->end) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
 int skAnimatorClampFrame(struct SKAnimator* animator, int frame) {
     if (frame < animator->currentClip->nFrames) {
         return frame;
@@ -229,6 +256,26 @@ void skAnimatorStep(struct SKAnimator* animator, float deltaTime) {
         lerpValue = 1.0f;
     }
 
+    int holdIndex = skAnimatorFindHold(currentClip, prevFrame, nextFrame);
+
+    if (holdIndex != -1) {
+        if (animator->holdIndex == holdIndex) {
+            // the pose hasn't changed so there is nothing to load
+            return;
+        }
+
+        int existingHoldFrame = skAnimatorBoneStateIndexInHold(animator, &currentClip->holds[holdIndex]);
+
+        if (existingHoldFrame != -1) {
+            animator->holdIndex = holdIndex;
+            animator->blendLerp = 1.0f;
+            animator->nextFrameStateIndex = existingHoldFrame;
+            return;
+        }
+    }
+
+    animator->holdIndex = holdIndex;
+
     int existingPrevFrame = skAnimatorBoneStateIndexOfFrame(animator, prevFrame);
     int existingNextFrame = skAnimatorBoneStateIndexOfFrame(animator, nextFrame);
 
@@ -281,7 +328,11 @@ void skAnimatorUpdate(struct SKAnimator* animator, struct Transform* transforms,
         return;
     }
 
-    skAnimatorReadTransform(animator, transforms);
+    // the transforms already hold this pose
+    if (animator->holdIndex == -1 || animator->holdIndex != animator->poseHoldIndex) {
+        skAnimatorReadTransform(animator, transforms);
+        animator->poseHoldIndex = animator->holdIndex;
+    }
 
     if (animator->flags & SKAnimatorFlagsDone) {
         animator->currentClip = NULL;
@@ -304,6 +355,8 @@ void skAnimatorRunClip(struct SKAnimator* animator, struct SKAnimationClip* clip
     
     animator->boneStateFrames[0] = -1;
     animator->boneStateFrames[1] = -1;
+    animator->holdIndex = -1;
+    animator->poseHoldIndex = -1;
 
     animator->blendLerp = 1.0f;
 
@@ -317,6 +370,10 @@ int skAnimatorIsRunning(struct SKAnimator* animator) {
     return animator->currentClip != NULL;
 }
 
+int skAnimatorIsHolding(struct SKAnimator* animator) {
+    return animator->currentClip != NULL && animator->holdIndex != -1;
+}
+
 static unsigned gSegmentLocations[SK_SEGMENT_COUNT];
 
 void skSetSegmentLocation(unsigned segmentNumber, unsigned segmentLocation) {
@@ -18,6 +18,10 @@ struct SKAnimator {
     short nextFrameStateIndex;
     short flags;
     short nBones;
+    // hold range the loaded bone states are in or -1
+    short holdIndex;
+    // hold range last written to the transforms or -1
+    short poseHoldIndex;
 };
 
 void skAnimatorInit(struct SKAnimator* animator, int nBones);
@@ -27,6 +31,8 @@ void skAnimatorUpdate(struct SKAnimator* animator, struct Transform* transforms,
 void skAnimatorRunClip(struct SKAnimator* animator, struct SKAnimationClip* clip, float startTime, int flags);
 
 int skAnimatorIsRunning(struct SKAnimator* animator);
+// the current clip is sitting on a held pose
+int skAnimatorIsHolding(struct SKAnimator* animator);
 
 void skAnimatorSync();
 
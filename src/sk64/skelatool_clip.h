@@ -17,11 +17,19 @@ struct SKAnimationBoneFrame {
     struct SKU16Vector3 rotation;
 };
 
+// frames start through end (inclusive) all have the same pose
+struct SKAnimationHoldRange {
+    short start;
+    short end;
+};
+
 struct SKAnimationClip {
     short nFrames;
     short nBones;
     struct SKAnimationBoneFrame* frames;
     float fps;
+    struct SKAnimationHoldRange* holds;
+    short nHolds;
 };
 
 #endif
\ No newline at end of file
@@ -1,6 +1,8 @@
 #include "dynamic_asset_loader.h"
 #include "memory.h"
 #include "rom.h"
+#include "relocation.h"
+#include "time.h"
 #include "../graphics/profile_task.h"
 
 #include "../build/assets/models/dynamic_model_list.h"
@@ -11,6 +13,21 @@ extern struct DynamicAnimatedAssetModel gDynamicAnimatedModels[];
 
 Gfx* gLoadedModels[DYNAMIC_MODEL_COUNT];
 u32 gModelPointerOffset[DYNAMIC_MODEL_COUNT];
+void* gModelMemory[DYNAMIC_MODEL_COUNT];
+u32 gModelSize[DYNAMIC_MODEL_COUNT];
+int gModelLastUsed[DYNAMIC_MODEL_COUNT];
+// pinned models are modified at runtime so they are never evicted
+u8 gModelPinned[DYNAMIC_MODEL_COUNT];
+
+// a model drawn within this many frames may still be
+// referenced by a display list the rdp hasn't finished
+#define DYNAMIC_ASSET_EVICT_FRAMES      3
+// prefetched models get some time to be drawn before
+// they are considered for eviction
+#define DYNAMIC_ASSET_PREFETCH_GRACE    60
+
+u32 gDynamicAssetBudget = DYNAMIC_ASSET_DEFAULT_BUDGET;
+u32 gDynamicAssetResidentBytes;
 
 struct SKArmatureWithAnimations gLoadedAnimatedModels[DYNAMIC_ANIMATED_MODEL_COUNT];
 
@@ -37,61 +54,33 @@ struct SKAnimationClip gBlankClip = {
     0,
     NULL,
     0,
+    NULL,
+    0,
 };
 
 void dynamicAssetsReset() {
     zeroMemory(gLoadedModels, sizeof(gLoadedModels));
+    zeroMemory(gModelMemory, sizeof(gModelMemory));
+    zeroMemory(gModelSize, sizeof(gModelSize));
+    zeroMemory(gModelLastUsed, sizeof(gModelLastUsed));
+    zeroMemory(gModelPinned, sizeof(gModelPinned));
     zeroMemory(gLoadedAnimatedModels, sizeof(gLoadedAnimatedModels));
+    gDynamicAssetResidentBytes = 0;
 }
 
-#define ADJUST_POINTER_POS(ptr, offset) (void*)((ptr) ? (char*)(ptr) + (offset) : 0)
-
-Gfx* dynamicAssetFixModelPointers(Gfx* gfx, u32 pointerOffset, u32 segmentStart, u32 segmentEnd) {
-    // only adjust pointers that land within the segment
-    if ((u32)gfx < segmentStart || (u32)gfx >= segmentEnd) {
-        return gfx;
-    }
-
-    gfx = ADJUST_POINTER_POS(gfx, pointerOffset);
-
-    Gfx* result = gfx;
-
-    // prevent an infinite loop if G_ENDL isn't found
-    Gfx* maxGfx = ADJUST_POINTER_POS(segmentEnd, pointerOffset);
-    while (gfx < maxGfx) {
-        int commandType = _SHIFTR(gfx->words.w0, 24, 8);
-
-        switch (commandType) {
-            case G_ENDDL:
-                return result;
-            case G_DL:
-                if (gfx->dma.par == G_DL_NOPUSH) {
-                    break;
-                }
-                gfx->dma.addr = (u32)dynamicAssetFixModelPointers((Gfx*)gfx->dma.addr, pointerOffset, segmentStart, segmentEnd);
-                break;
-            case G_VTX:
-                gfx->dma.addr = (u32)ADJUST_POINTER_POS(gfx->dma.addr, pointerOffset);
-                break;
-        };
-
-        ++gfx;
-    }
-
-    return NULL;
+void dynamicAssetSetBudget(u32 bytes) {
+    gDynamicAssetBudget = bytes;
 }
 
-Gfx* dynamicAssetLoadModel(struct DynamicAssetModel* model, u32* pointerOffset) {
+Gfx* dynamicAssetLoadModel(struct DynamicAssetModel* model, u32* pointerOffset, void** memory) {
     u32 length = (u32)model->addressEnd - (u32)model->addressStart;
     void* assetMemoryChunk = malloc(length);
     romCopy(model->addressStart, assetMemoryChunk, length);
     *pointerOffset = (u32)assetMemoryChunk - (u32)model->segmentStart;
-    Gfx* result = dynamicAssetFixModelPointers(model->model, *pointerOffset, (u32)model->segmentStart, (u32)model->segmentStart + length);
+    *memory = assetMemoryChunk;
 
-    if (!result) {
-        free(assetMemoryChunk);
-        *pointerOffset = 0;
-    }
+    relocationApplyAll(ADJUST_POINTER_POS(model->relocations, *pointerOffset), *pointerOffset);
+    Gfx* result = ADJUST_POINTER_POS(model->model, *pointerOffset);
 
     profileMapAddress(result, model->name);
 
@@ -104,33 +93,110 @@ void dynamicAssetLoadAnimatedModel(struct DynamicAnimatedAssetModel* model, stru
     romCopy(model->addressStart, assetMemoryChunk, length);
     u32 pointerOffset = (u32)assetMemoryChunk - (u32)model->segmentStart;
 
-    result->armature = ADJUST_POINTER_POS(model->armature, pointerOffset);
+    // animated models are held onto by their animators so
+    // they count against the budget but are never evicted
+    gDynamicAssetResidentBytes += length;
 
-    result->armature->displayList = dynamicAssetFixModelPointers(result->armature->displayList, pointerOffset, (u32)model->segmentStart, (u32)model->segmentStart + length);
-    result->armature->pose = ADJUST_POINTER_POS(result->armature->pose, pointerOffset);
-    result->armature->boneParentIndex = ADJUST_POINTER_POS(result->armature->boneParentIndex, pointerOffset);
+    relocationApplyAll(ADJUST_POINTER_POS(model->relocations, pointerOffset), pointerOffset);
 
+    result->armature = ADJUST_POINTER_POS(model->armature, pointerOffset);
     result->clips = ADJUST_POINTER_POS(model->clips, pointerOffset);
+    result->clipCount = model->clipCount;
 
-    for (int i = 0; i < model->clipCount; i++) {
-        result->clips[i] = ADJUST_POINTER_POS(result->clips[i], pointerOffset);
+    profileMapAddress(result->armature->displayList, model->name);
+}
+
+static u32 dynamicAssetModelSize(int index) {
+    return (u32)gDynamicModels[index].addressEnd - (u32)gDynamicModels[index].addressStart;
+}
+
+static void dynamicAssetEvict(int index) {
+    free(gModelMemory[index]);
+    gDynamicAssetResidentBytes -= gModelSize[index];
+    gLoadedModels[index] = NULL;
+    gModelMemory[index] = NULL;
+}
+
+// evicts the least recently used models until size bytes
+// fit in the budget. Returns 0 if there wasn't enough to evict
+static int dynamicAssetMakeRoom(u32 size) {
+    while (gDynamicAssetResidentBytes + size > gDynamicAssetBudget) {
+        int oldestIndex = -1;
+        int oldestFrame = gCurrentFrame - DYNAMIC_ASSET_EVICT_FRAMES;
+
+        for (int i = 0; i < DYNAMIC_MODEL_COUNT; ++i) {
+            if (gLoadedModels[i] && !gModelPinned[i] && gModelLastUsed[i] < oldestFrame) {
+                oldestIndex = i;
+                oldestFrame = gModelLastUsed[i];
+            }
+        }
+
+        if (oldestIndex == -1) {
+            return 0;
+        }
+
+        dynamicAssetEvict(oldestIndex);
     }
 
-    result->clipCount = model->clipCount;
+    return 1;
+}
 
-    profileMapAddress(result->armature->displayList, model->name);
+static void dynamicAssetLoadIndex(int index) {
+    gLoadedModels[index] = dynamicAssetLoadModel(&gDynamicModels[index], &gModelPointerOffset[index], &gModelMemory[index]);
+    gModelSize[index] = dynamicAssetModelSize(index);
+    gDynamicAssetResidentBytes += gModelSize[index];
+}
+
+// models that are needed always get loaded even if
+// that means going over budget
+static int dynamicAssetEnsureLoaded(int index) {
+    if (index < 0 || index >= DYNAMIC_MODEL_COUNT) {
+        return 0;
+    }
+
+    if (!gLoadedModels[index]) {
+        dynamicAssetMakeRoom(dynamicAssetModelSize(index));
+        dynamicAssetLoadIndex(index);
+    }
+
+    gModelLastUsed[index] = gCurrentFrame;
+
+    return 1;
 }
 
 void dynamicAssetModelPreload(int index) {
-    if (index < 0 || index >= DYNAMIC_MODEL_COUNT || gLoadedModels[index] ) {
+    dynamicAssetEnsureLoaded(index);
+}
+
+void dynamicAssetModelPin(int index) {
+    if (dynamicAssetEnsureLoaded(index)) {
+        gModelPinned[index] = 1;
+    }
+}
+
+void dynamicAssetModelPrefetch(int index) {
+    if (index < 0 || index >= DYNAMIC_MODEL_COUNT) {
         return;
     }
 
-    gLoadedModels[index] = dynamicAssetLoadModel(&gDynamicModels[index], &gModelPointerOffset[index]);
+    if (!gLoadedModels[index]) {
+        if (!dynamicAssetMakeRoom(dynamicAssetModelSize(index))) {
+            return;
+        }
+
+        dynamicAssetLoadIndex(index);
+    }
+
+    if (gModelLastUsed[index] < gCurrentFrame + DYNAMIC_ASSET_PREFETCH_GRACE) {
+        gModelLastUsed[index] = gCurrentFrame + DYNAMIC_ASSET_PREFETCH_GRACE;
+    }
 }
 
+// an evicted model is loaded right away so it never
+// pops out for a frame. The neighbouring room prefetch
+// keeps this from happening when walking between rooms
 Gfx* dynamicAssetModel(int index) {
-    if (index < 0 || index >= DYNAMIC_MODEL_COUNT || !gLoadedModels[index]) {
+    if (!dynamicAssetEnsureLoaded(index)) {
         return gBlankGfx;
     }
 
@@ -138,7 +204,7 @@ Gfx* dynamicAssetModel(int index) {
 }
 
 void* dynamicAssetFixPointer(int index, void* ptr) {
-    if (index < 0 || index >= DYNAMIC_MODEL_COUNT || !gLoadedModels[index]) {
+    if (!dynamicAssetEnsureLoaded(index)) {
         return NULL;
     }
 
@@ -11,6 +11,7 @@ struct DynamicAssetModel {
     void* addressEnd;
     void* segmentStart;
     Gfx* model;
+    void*** relocations;
     char* name;
 };
 
@@ -21,6 +22,7 @@ struct DynamicAnimatedAssetModel {
     struct SKArmatureDefinition* armature;
     struct SKAnimationClip** clips;
     short clipCount;
+    void*** relocations;
     char* name;
 };
 
@@ -30,9 +32,18 @@ struct SKArmatureWithAnimations {
     short clipCount;
 };
 
+// dynamic models that haven't been drawn recently are
+// evicted to keep the total size under this budget
+#define DYNAMIC_ASSET_DEFAULT_BUDGET    (128 * 1024)
+
 void dynamicAssetsReset();
+void dynamicAssetSetBudget(u32 bytes);
 
 void dynamicAssetModelPreload(int index);
+// for models that are modified after loading, a reload would lose the changes
+void dynamicAssetModelPin(int index);
+// loads a model that is likely to be needed soon if it fits in the budget
+void dynamicAssetModelPrefetch(int index);
 Gfx* dynamicAssetModel(int index);
 
 void* dynamicAssetFixPointer(int index, void* ptr);
@@ -270,6 +270,46 @@ void free(void* target)
     insertHeapSegment(0, (struct HeapSegment*)segment);
 }
 
+// resets the heap but keeps a single block returned from malloc intact.
+// The block is moved to the end of the heap so the free memory is a
+// single block. Returns where the block ended up
+void* heapInitPreserving(void* heapStart, void* heapEnd, void* preserve)
+{
+    if (!preserve) {
+        heapInit(heapStart, heapEnd);
+        return 0;
+    }
+
+    struct HeapUsedSegment* preservedSegment = (struct HeapUsedSegment*)preserve - 1;
+    int preservedSize = (char*)preservedSegment->segmentEnd - (char*)preservedSegment;
+
+    struct HeapUsedSegment* movedSegment = (struct HeapUsedSegment*)(((int)heapEnd - preservedSize) & ~0x7);
+
+    if (movedSegment != preservedSegment) {
+        // moving towards the end of the heap so copy
+        // backwards in case the old and new block overlap
+        long long* src = (long long*)preservedSegment->segmentEnd;
+        long long* dst = (long long*)((char*)movedSegment + preservedSize);
+
+        while (src > (long long*)preservedSegment) {
+            *--dst = *--src;
+        }
+    }
+
+    gHeapStart = (void*)(((int)heapStart + 7) & ~0x7);
+    gHeapEnd = heapEnd;
+    gFirstFreeSegment = 0;
+
+    if ((char*)movedSegment - (char*)gHeapStart >= (int)MIN_HEAP_BLOCK_SIZE) {
+        gFirstFreeSegment = (struct HeapSegment*)gHeapStart;
+        heapInitBlock(gFirstFreeSegment, movedSegment, MALLOC_FREE_BLOCK);
+    }
+
+    heapInitBlock((struct HeapSegment*)movedSegment, (char*)movedSegment + preservedSize, MALLOC_USED_BLOCK);
+
+    return movedSegment + 1;
+}
+
 int calculateHeapSize() {
     return (char*)gHeapEnd - (char*)gHeapStart;
 }
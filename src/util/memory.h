@@ -38,6 +38,7 @@ struct HeapSegmentFooter
 #define MIN_HEAP_BLOCK_SIZE (sizeof(struct HeapSegment) + sizeof(struct HeapSegmentFooter))
 
 void heapInit(void* heapStart, void* heapEnd);
+void* heapInitPreserving(void* heapStart, void* heapEnd, void* preserve);
 void heapReset();
 void *cacheFreePointer(void* target);
 void *malloc(unsigned int size);
@@ -0,0 +1,42 @@
+#include "relocation.h"
+
+int relocationApply(void*** table, int pointerOffset, int start, int maxCount) {
+    void*** curr = table + start;
+    void*** end = curr + maxCount;
+
+    while (curr < end) {
+        if (!*curr) {
+            return RELOCATION_DONE;
+        }
+
+        // the table entries are link time addresses too
+        void** field = ADJUST_POINTER_POS(*curr, pointerOffset);
+        *field = ADJUST_POINTER_POS(*field, pointerOffset);
+
+        ++curr;
+    }
+
+    return curr - table;
+}
+
+void relocationApplyAll(void*** table, int pointerOffset) {
+    if (!table) {
+        return;
+    }
+
+    for (void*** curr = table; *curr; ++curr) {
+        void** field = ADJUST_POINTER_POS(*curr, pointerOffset);
+        *field = ADJUST_POINTER_POS(*field, pointerOffset);
+    }
+}
+
+void relocationShift(void*** table, int pointerOffset, int delta) {
+    if (!table) {
+        return;
+    }
+
+    for (void*** curr = table; *curr; ++curr) {
+        void** field = ADJUST_POINTER_POS(*curr, pointerOffset);
+        *field = ADJUST_POINTER_POS(*field, delta);
+    }
+}
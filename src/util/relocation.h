@@ -0,0 +1,18 @@
+#ifndef __UTIL_RELOCATION_H__
+#define __UTIL_RELOCATION_H__
+
+#define ADJUST_POINTER_POS(ptr, offset) (void*)((ptr) ? (char*)(ptr) + (offset) : 0)
+
+#define RELOCATION_DONE -1
+
+// tables are generated by skelatool64 and are a null terminated
+// list of every pointer in a segment that points back into the segment
+// processes at most maxCount entries starting at start and returns where to
+// continue from or RELOCATION_DONE once the end of the table is reached
+int relocationApply(void*** table, int pointerOffset, int start, int maxCount);
+void relocationApplyAll(void*** table, int pointerOffset);
+// moves the pointers of a segment that was already relocated and then
+// copied delta bytes away. pointerOffset is for the new location
+void relocationShift(void*** table, int pointerOffset, int delta);
+
+#endif
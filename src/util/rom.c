@@ -27,4 +27,16 @@ void romCopy(const char *src, const char *dest, const int len)
 
     osEPiStartDma(gPiHandle, &dmaIoMesgBuf, OS_READ);
     (void) osRecvMesg(&dmaMessageQ, &dummyMesg, OS_MESG_BLOCK);
+}
+
+void romCopyAsync(const char *src, const char *dest, const int len, OSIoMesg* ioMesg, OSMesgQueue* retQueue) {
+    osInvalDCache((void *)dest, (s32) len);
+
+    ioMesg->hdr.pri      = OS_MESG_PRI_NORMAL;
+    ioMesg->hdr.retQueue = retQueue;
+    ioMesg->dramAddr     = (void*)dest;
+    ioMesg->devAddr      = (u32)src;
+    ioMesg->size         = (u32)len;
+
+    osEPiStartDma(gPiHandle, ioMesg, OS_READ);
 }
\ No newline at end of file
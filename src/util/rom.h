@@ -1,10 +1,13 @@
 #ifndef _ROM_UTIL_H
 #define _ROM_UTIL_H
 
+#include <ultra64.h>
 #include "memory.h"
 
 void romInit();
 void romCopy(const char *src, const char *dest, const int len);
+// starts the dma and returns immediately, ioMesg is posted to retQueue once the copy finishes
+void romCopyAsync(const char *src, const char *dest, const int len, OSIoMesg* ioMesg, OSMesgQueue* retQueue);
 
 #define LOAD_SEGMENT(segmentName, dest)                                 \
     dest = malloc((u32)(_ ## segmentName ## SegmentRomEnd - _ ## segmentName ## SegmentRomStart));                                     \
@@ -0,0 +1,95 @@
+const fs = require('fs');
+const path = require('path');
+const crypto = require('crypto');
+const child_process = require('child_process');
+
+// converts a single clip described by a .sox, .jsox or .msox file into an
+// aifc. Results are cached by the contents of the source audio and the
+// conversion parameters so extracting the same files again, such as when
+// the language packs are unpacked, doesn't convert everything again
+
+// bump this to invalidate the cache when the conversion steps change
+const CACHE_VERSION = '1';
+
+let cacheDir = 'build/sound_cache';
+let sfz2n64 = 'sfz2n64';
+let inputs = [];
+let lastCommand = '';
+
+for (let i = 2; i < process.argv.length; ++i) {
+    const arg = process.argv[i];
+    if (lastCommand) {
+        if (lastCommand == '--cache') {
+            cacheDir = arg;
+        } else if (lastCommand == '--sfz2n64') {
+            sfz2n64 = arg;
+        }
+        lastCommand = '';
+    } else if (arg[0] == '-') {
+        lastCommand = arg;
+    } else {
+        inputs.push(arg);
+    }
+}
+
+if (inputs.length != 3) {
+    console.error('usage: node convert_sound.js [--cache dir] [--sfz2n64 path] attributes source output.aifc');
+    process.exit(1);
+}
+
+const [attributesFile, sourceFile, outputFile] = inputs;
+const extension = path.extname(attributesFile);
+const attributes = fs.readFileSync(attributesFile);
+const wavFile = outputFile.replace(/\.aifc$/, '.wav');
+
+function run(command) {
+    console.log(command);
+    child_process.execSync(command, {stdio: 'inherit'});
+}
+
+function soxCommands() {
+    if (extension == '.jsox') {
+        return JSON.parse(attributes).map((command) =>
+            `sox ${sourceFile} ${command.flags || ''} ${wavFile} ${command.filters || ''}`
+        );
+    }
+
+    return [`sox ${sourceFile} ${attributes.toString().trim()} ${wavFile}`];
+}
+
+function convert() {
+    if (extension == '.msox') {
+        run(`mpg123 -w ${sourceFile} ${sourceFile.replace(/\.wav$/, '.mp3')}`);
+    }
+
+    soxCommands().forEach(run);
+    run(`${sfz2n64} -o ${outputFile} ${wavFile}`);
+}
+
+function cacheKey() {
+    const hash = crypto.createHash('sha1');
+    hash.update(CACHE_VERSION);
+    hash.update(extension);
+    hash.update(attributes);
+
+    const audioSource = extension == '.msox' ? sourceFile.replace(/\.wav$/, '.mp3') : sourceFile;
+    hash.update(fs.readFileSync(audioSource));
+
+    return hash.digest('hex');
+}
+
+const key = cacheKey();
+const cachedFile = path.join(cacheDir, key + '.aifc');
+
+fs.mkdirSync(path.dirname(outputFile), {recursive: true});
+
+if (fs.existsSync(cachedFile)) {
+    fs.copyFileSync(cachedFile, outputFile);
+} else {
+    convert();
+    fs.mkdirSync(cacheDir, {recursive: true});
+    // write then rename so parallel jobs never see a partial file
+    const tmpFile = cachedFile + '.' + process.pid;
+    fs.copyFileSync(outputFile, tmpFile);
+    fs.renameSync(tmpFile, cachedFile);
+}
@@ -11,6 +11,8 @@ local signals = require('tools.level_scripts.signals')
 local animation = require('tools.level_scripts.animation')
 local dynamic_collision = require('tools.level_scripts.dynamic_collision_export')
 
+local relocations = sk_definition_writer.add_relocation_table("relocations", "_geo")
+
 sk_definition_writer.add_definition("level", "struct LevelDefinition", "_geo", {
     collisionQuads = sk_definition_writer.reference_to(collision_export.collision_objects, 1),
     collisionQuadCount = #collision_export.collision_objects,
@@ -18,7 +20,7 @@ sk_definition_writer.add_definition("level", "struct LevelDefinition", "_geo", {
     staticContentCount = #static_export.static_content_elements,
     roomBvhList = sk_definition_writer.reference_to(static_export.room_bvh_list, 1),
     signalToStaticRanges = sk_definition_writer.reference_to(static_export.signal_ranges, 1),
-    signalToStaticIndices = sk_definition_writer.reference_to(static_export.signal_indices, 1),
+    signalToStaticSwaps = sk_definition_writer.reference_to(static_export.signal_swaps, 1),
     signalToStaticCount = #static_export.signal_ranges,
     roomStaticMapping = sk_definition_writer.reference_to(static_export.room_ranges, 1),
     portalSurfaces = sk_definition_writer.reference_to(portal_surfaces.portal_surfaces, 1),
@@ -67,4 +69,5 @@ sk_definition_writer.add_definition("level", "struct LevelDefinition", "_geo", {
     clockCount = #entities.clocks,
     securityCameras = sk_definition_writer.reference_to(entities.security_cameras, 1),
     securityCameraCount = #entities.security_cameras,
+    relocations = sk_definition_writer.raw(relocations),
 })
\ No newline at end of file
@@ -119,6 +119,116 @@ function searchForBestHashTable(list, hashFunction, emptyObj) {
     return {result: result.sparseArray, multiplier: multiplier, mask: mask, maxCollisions: result.maxCollisions, averageCollisions: result.averageCollisions};
 }
 
+// must match FONT_GLYPH_PAGE_SHIFT in font.h
+const GLYPH_PAGE_SHIFT = 6;
+const GLYPH_PAGE_SIZE = 1 << GLYPH_PAGE_SHIFT;
+const GLYPH_NO_PAGE = 0xFF;
+// pages with fewer glyphs than this are left to the hash table
+const MIN_GLYPHS_PER_PAGE = 2;
+// skip the kerning matrix if it would be larger than this many bytes
+const MAX_KERNING_MATRIX_SIZE = 0x2000;
+
+function buildGlyphTables(sparseSymbols) {
+    const pageCounts = new Map();
+
+    sparseSymbols.forEach((symbol) => {
+        if (symbol.textureIndex == -1) {
+            return;
+        }
+
+        const page = symbol.id >> GLYPH_PAGE_SHIFT;
+        pageCounts.set(page, (pageCounts.get(page) || 0) + 1);
+    });
+
+    const densePages = [...pageCounts.keys()]
+        .filter(page => pageCounts.get(page) >= MIN_GLYPHS_PER_PAGE)
+        .sort((a, b) => a - b)
+        .slice(0, GLYPH_NO_PAGE);
+
+    const pageCount = densePages.length ? densePages[densePages.length - 1] + 1 : 0;
+    const pages = new Array(pageCount).fill(GLYPH_NO_PAGE);
+    const indices = new Array(densePages.length * GLYPH_PAGE_SIZE).fill(-1);
+
+    densePages.forEach((page, pageIndex) => {
+        pages[page] = pageIndex;
+    });
+
+    sparseSymbols.forEach((symbol, symbolIndex) => {
+        if (symbol.textureIndex == -1) {
+            return;
+        }
+
+        const pageIndex = pages[symbol.id >> GLYPH_PAGE_SHIFT];
+
+        if (pageIndex === undefined || pageIndex == GLYPH_NO_PAGE) {
+            return;
+        }
+
+        indices[pageIndex * GLYPH_PAGE_SIZE + (symbol.id & (GLYPH_PAGE_SIZE - 1))] = symbolIndex;
+    });
+
+    return {pages, indices, pageCount};
+}
+
+function buildKerningMatrix(sparseSymbols, kerningList) {
+    const pairs = kerningList.filter(kerning => kerning.amount);
+    const firsts = [...new Set(pairs.map(kerning => kerning.first))];
+    const seconds = [...new Set(pairs.map(kerning => kerning.second))];
+
+    // both the matrix and the hashed table store the amount as a char
+    const outOfRange = pairs.find(kerning => kerning.amount < -128 || kerning.amount > 127);
+
+    if (outOfRange) {
+        throw new Error(`Kerning amount ${outOfRange.amount} between ${outOfRange.first} and ${outOfRange.second} does not fit in a char`);
+    }
+
+    if (!pairs.length || firsts.length > 0xFF || seconds.length > 0xFF || firsts.length * seconds.length > MAX_KERNING_MATRIX_SIZE) {
+        return null;
+    }
+
+    const matrix = new Array(firsts.length * seconds.length).fill(0);
+
+    pairs.forEach((kerning) => {
+        matrix[firsts.indexOf(kerning.first) * seconds.length + seconds.indexOf(kerning.second)] = kerning.amount;
+    });
+
+    // row and column 0 mean no kerning
+    const rows = sparseSymbols.map(symbol => symbol.textureIndex == -1 ? 0 : firsts.indexOf(symbol.id) + 1);
+    const columns = sparseSymbols.map(symbol => symbol.textureIndex == -1 ? 0 : seconds.indexOf(symbol.id) + 1);
+
+    return {rows, columns, matrix, columnCount: seconds.length};
+}
+
+function buildArray(type, arrayName, values) {
+    const lines = [];
+
+    for (let i = 0; i < values.length; i += 16) {
+        lines.push(`    ${values.slice(i, i + 16).join(', ')},`);
+    }
+
+    return `${type} ${arrayName}[] = {
+${lines.join('\n')}
+};
+`;
+}
+
+function buildLookupTables(glyphTables, kerningMatrix) {
+    const result = [];
+
+    if (glyphTables.pageCount) {
+        result.push(buildArray('unsigned char', `g${name}GlyphPages`, glyphTables.pages));
+        result.push(buildArray('short', `g${name}GlyphIndices`, glyphTables.indices));
+    }
+
+    if (kerningMatrix) {
+        result.push(buildArray('unsigned char', `g${name}KerningRows`, kerningMatrix.rows));
+        result.push(buildArray('unsigned char', `g${name}KerningColumns`, kerningMatrix.columns));
+        result.push(buildArray('signed char', `g${name}KerningMatrix`, kerningMatrix.matrix));
+    }
+
+    return result.join('\n');
+}
+
 function buildKerning(kerningList) {
     return `struct FontKerning g${name}Kerning[] = {
 ${kerningList.map(kerning => `    {.amount = ${kerning.amount}, .first = ${kerning.first}, .second = ${kerning.second}},`).join('\n')}
@@ -126,7 +236,7 @@ ${kerningList.map(kerning => `    {.amount = ${kerning.amount}, .first = ${kerni
 `
 }
 
-function buildFont(kerningResult, symbolResult) {
+function buildFont(kerningResult, symbolResult, glyphTables, kerningMatrix) {
     return `struct Font g${name}Font = {
     .kerning = &g${name}Kerning[0],
     .symbols = &g${name}Symbols[0],
@@ -138,6 +248,13 @@ function buildFont(kerningResult, symbolResult) {
     .kerningMultiplier = ${kerningResult.multiplier},
     .kerningMask = 0x${kerningResult.mask.toString(16)},
     .kerningMaxCollisions = ${kerningResult.maxCollisions},
+    .glyphPages = ${glyphTables.pageCount ? `&g${name}GlyphPages[0]` : 'NULL'},
+    .glyphIndices = ${glyphTables.pageCount ? `&g${name}GlyphIndices[0]` : 'NULL'},
+    .glyphPageCount = ${glyphTables.pageCount},
+    .kerningRows = ${kerningMatrix ? `&g${name}KerningRows[0]` : 'NULL'},
+    .kerningColumns = ${kerningMatrix ? `&g${name}KerningColumns[0]` : 'NULL'},
+    .kerningMatrix = ${kerningMatrix ? `&g${name}KerningMatrix[0]` : 'NULL'},
+    .kerningColumnCount = ${kerningMatrix ? kerningMatrix.columnCount : 0},
 };
 `
 }
@@ -165,12 +282,17 @@ const symbolResult = searchForBestHashTable(
     {id: 0, x: 0, y: 0, width: 0, height: 0, xoffset: 0, yoffset: 0, xadvance: 0, textureIndex: -1}
 );
 
+const glyphTables = buildGlyphTables(symbolResult.result);
+const kerningMatrix = buildKerningMatrix(symbolResult.result, input.kerning);
+
 console.log(`symbolLength = ${input.symbols.length}/${symbolResult.result.length}`);
 console.log(`symbolMaxCollisions = ${symbolResult.maxCollisions}`);
 console.log(`symbolAverageCollisions = ${symbolResult.averageCollisions}`);
 console.log(`kerningLength = ${input.kerning.length}/${kerningResult.result.length}`);
 console.log(`maxKerningCollisions = ${kerningResult.maxCollisions}`);
 console.log(`kerningAverageCollisions = ${kerningResult.averageCollisions}`);
+console.log(`glyphPages = ${glyphTables.indices.length / GLYPH_PAGE_SIZE}/${glyphTables.pageCount}`);
+console.log(`kerningMatrix = ${kerningMatrix ? `${kerningMatrix.matrix.length / kerningMatrix.columnCount}x${kerningMatrix.columnCount}` : 'none'}`);
 
 fs.writeFileSync(process.argv[4], `
 
@@ -182,5 +304,6 @@ struct FontSymbol g${name}Symbols[] = {
 ${symbolResult.result.map(buildSymbol).join('\n')}
 };
 
-${buildFont(kerningResult, symbolResult)}
+${buildLookupTables(glyphTables, kerningMatrix)}
+${buildFont(kerningResult, symbolResult, glyphTables, kerningMatrix)}
 `);
\ No newline at end of file
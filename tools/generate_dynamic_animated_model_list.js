@@ -34,6 +34,11 @@ function generateDynamicModelName(outputLocation, headerLocation, index) {
     return relative.replace(InvalidTokenCharacter, '_') + '_DYNAMIC_ANIMATED_MODEL';
 }
 
+function generateRelocationsName(outputLocation, headerLocation) {
+    const relative = path.relative(path.dirname(outputLocation), headerLocation).slice(0, -2);
+    return relative.replace(InvalidTokenCharacter, '_') + '_relocations';
+}
+
 function generateMetadata(outputLocation, headerLocation) {
     const segmentName = getSegmentName(headerLocation);
     return `    {
@@ -43,6 +48,7 @@ function generateMetadata(outputLocation, headerLocation) {
         &${generateArmatureName(outputLocation, headerLocation)},
         ${generateClipsName(outputLocation, headerLocation)},
         ${generateClipCountName(outputLocation, headerLocation)},
+        ${generateRelocationsName(outputLocation, headerLocation)},
         "${segmentName}", 
     },`;
 }
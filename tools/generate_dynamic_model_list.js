@@ -24,6 +24,11 @@ function generateDynamicModelName(outputLocation, headerLocation, index) {
     return relative.replace(InvalidTokenCharacter, '_') + '_dynamic_model';
 }
 
+function generateRelocationsName(outputLocation, headerLocation) {
+    const relative = path.relative(path.dirname(outputLocation), headerLocation).slice(0, -2);
+    return relative.replace(InvalidTokenCharacter, '_') + '_relocations';
+}
+
 function generateMetadata(outputLocation, headerLocation) {
     const segmentName = getSegmentName(headerLocation);
     return `    {
@@ -31,6 +36,7 @@ function generateMetadata(outputLocation, headerLocation) {
         _${segmentName}_geoSegmentRomEnd,
         _${segmentName}_geoSegmentStart,
         ${generateModelName(outputLocation, headerLocation)},
+        ${generateRelocationsName(outputLocation, headerLocation)},
         "${segmentName}",
     },`;
 }
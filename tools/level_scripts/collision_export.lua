@@ -310,21 +310,22 @@ for index, node in pairs(collider_nodes) do
         table.insert(colliders, collider)
         table.insert(quad_rooms, node.room_index)
 
+        -- named fields so relocation entries can point at them
         local collider_type = {
-            sk_definition_writer.raw("CollisionShapeTypeQuad"),
-            sk_definition_writer.reference_to(collider),
-            0,
-            1,
-            sk_definition_writer.null_value,
+            type = sk_definition_writer.raw("CollisionShapeTypeQuad"),
+            data = sk_definition_writer.reference_to(collider),
+            bounce = 0,
+            friction = 1,
+            callbacks = sk_definition_writer.null_value,
         }
         
         table.insert(collider_types, collider_type)
 
         table.insert(collision_objects, {
-            sk_definition_writer.reference_to(collider_type),
-            sk_definition_writer.null_value,
-            bb,
-            sk_definition_writer.raw(table.concat(collision_layers, ' | '))
+            collider = sk_definition_writer.reference_to(collider_type),
+            body = sk_definition_writer.null_value,
+            boundingBox = bb,
+            collisionLayers = sk_definition_writer.raw(table.concat(collision_layers, ' | ')),
         })
     end
 end
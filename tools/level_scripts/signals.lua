@@ -30,7 +30,25 @@ local function get_signal_count()
     return signal_count
 end
 
+-- duration is stored in hundredths of a second
+-- must match SIGNAL_TIMER_TICKS_PER_SECOND in signals.h
+local TIMER_TICKS_PER_SECOND = 100
+
 local function generate_operator_data(operator)
+    if operator.type == 'SignalOperatorTypeTimer' then
+        return {
+            sk_definition_writer.raw(operator.type),
+            signal_index_for_name(operator.output),
+            {
+                signal_index_for_name(operator.input[1]),
+                -1,
+            },
+            {
+                duration = math.floor(operator.duration * TIMER_TICKS_PER_SECOND + 0.5),
+            },
+        }
+    end
+
     return {
         sk_definition_writer.raw(operator.type),
         signal_index_for_name(operator.output),
@@ -82,13 +100,100 @@ local function parse_operation(str_value)
         }
     end
 
-    error('operator must be of the form not a, a and b, a or b')
+    if inputs[1] == 'timer' and #inputs == 3 then
+        local duration = tonumber(inputs[3])
+
+        if not duration or duration <= 0 or duration * TIMER_TICKS_PER_SECOND > 0x7FFF then
+            error('timer duration must be a number of seconds between 0 and ' .. (0x7FFF / TIMER_TICKS_PER_SECOND))
+        end
+
+        return {
+            type = 'SignalOperatorTypeTimer',
+            output = output,
+            input = {inputs[2]},
+            duration = duration,
+        }
+    end
+
+    error('operator must be of the form not a, a and b, a or b, timer a seconds')
 end
 
-local operators = {}
+-- orders the operators so every operator comes after the operators
+-- that write to its inputs. That way a chain of operators settles in
+-- a single frame and each operator only needs to check if its inputs
+-- changed. Operators that are part of a loop keep their original order
+local function sort_operations(operations)
+    local writers = {}
+
+    for index, operation in pairs(operations) do
+        local list = writers[operation.output] or {}
+        table.insert(list, index)
+        writers[operation.output] = list
+    end
+
+    local dependency_count = {}
+    local dependents = {}
+
+    for index, operation in pairs(operations) do
+        dependency_count[index] = 0
+        dependents[index] = {}
+    end
+
+    for index, operation in pairs(operations) do
+        for _, input in pairs(operation.input) do
+            for _, writer in pairs(writers[input] or {}) do
+                dependency_count[index] = dependency_count[index] + 1
+                table.insert(dependents[writer], index)
+            end
+        end
+    end
+
+    local result = {}
+    local added = {}
+
+    while #result < #operations do
+        local next_index = nil
+
+        -- the lowest ready index keeps the output stable
+        for index = 1, #operations do
+            if not added[index] and dependency_count[index] == 0 then
+                next_index = index
+                break
+            end
+        end
+
+        if not next_index then
+            for index = 1, #operations do
+                if not added[index] then
+                    next_index = index
+                    break
+                end
+            end
+
+            print('signal operator ' .. operations[next_index].output .. ' is part of a loop and may take more than a frame to settle')
+        end
+
+        added[next_index] = true
+        table.insert(result, operations[next_index])
+
+        for _, dependent in pairs(dependents[next_index]) do
+            dependency_count[dependent] = dependency_count[dependent] - 1
+        end
+    end
+
+    return result
+end
+
+local operations = {}
 
 for _, operation in pairs(yaml_loader.json_contents.operators or {}) do
-    table.insert(operators, generate_operator_data(parse_operation(operation)))
+    table.insert(operations, parse_operation(operation))
+end
+
+local operators = {}
+
+for _, operation in pairs(sort_operations(operations)) do
+    table.insert(operators, generate_operator_data(operation))
 end
 
 sk_definition_writer.add_definition('signal_operations', 'struct SignalOperator[]', '_geo', operators)
@@ -411,6 +411,23 @@ end
 
 local static_nodes, room_bvh_list = process_static_nodes(sk_scene.nodes_for_type('@static'))
 
+-- materials that switch when the signal of an indicator_lights
+-- element changes
+local signal_material_pairs = {
+    {off = 'INDICATOR_LIGHTS_INDEX', on = 'INDICATOR_LIGHTS_ON_INDEX'},
+    {off = 'SIGNAGE_DOORSTATE_INDEX', on = 'SIGNAGE_DOORSTATE_ON_INDEX'},
+}
+
+local function signal_material_pair(material_index)
+    for _, pair in pairs(signal_material_pairs) do
+        if pair.off == material_index or pair.on == material_index then
+            return pair
+        end
+    end
+
+    return nil
+end
+
 local static_content_elements = {}
 
 local room_ranges = {}
@@ -425,7 +442,15 @@ for index, static_node in pairs(static_nodes) do
             table.insert(signal_elements, {})
         end
 
-        table.insert(signal_elements[signal_number], #static_content_elements)
+        local signal_materials = signal_material_pair(static_node.material_index.value)
+
+        if signal_materials then
+            table.insert(signal_elements[signal_number], {
+                #static_content_elements,
+                sk_definition_writer.raw(signal_materials.off),
+                sk_definition_writer.raw(signal_materials.on),
+            })
+        end
     end
 
     table.insert(static_content_elements, {
@@ -452,25 +477,25 @@ end
 sk_definition_writer.add_definition("static", "struct StaticContentElement[]", "_geo", static_content_elements)
 sk_definition_writer.add_definition("room_mapping", "struct Rangeu16[]", "_geo", room_ranges)
 
-local signal_indices = {}
+local signal_swaps = {}
 local signal_ranges = {}
 
 for _, element in pairs(signal_elements) do
-    table.insert(signal_ranges, {#signal_indices, #signal_indices + #element})
+    table.insert(signal_ranges, {#signal_swaps, #signal_swaps + #element})
 
-    for _, index in pairs(element) do
-        table.insert(signal_indices, index)
+    for _, swap in pairs(element) do
+        table.insert(signal_swaps, swap)
     end
 end
 
 sk_definition_writer.add_definition("signal_ranges", "struct Rangeu16[]", "_geo", signal_ranges)
-sk_definition_writer.add_definition('signal_indices', 'u16[]', '_geo', signal_indices)
+sk_definition_writer.add_definition('signal_swaps', 'struct SignalMaterialSwap[]', '_geo', signal_swaps)
 
 return {
     static_nodes = static_nodes,
     static_content_elements = static_content_elements,
     room_ranges = room_ranges,
     signal_ranges = signal_ranges,
-    signal_indices = signal_indices,
+    signal_swaps = signal_swaps,
     room_bvh_list = room_bvh_list,
 }
\ No newline at end of file
@@ -83,11 +83,60 @@ local function find_label_locations(steps)
     return result
 end
 
+-- follows chains of gotos so the runtime only ever has to jump once
+local function resolve_goto_target(cutscene_name, steps, label_locations, label)
+    local target = label_locations[label]
+    local visited = {}
+
+    while true do
+        if not target then
+            error("Unrecognized label '" .. label .. "' in cutscene " .. cutscene_name)
+        end
+
+        local target_step = steps[target]
+
+        if not target_step or target_step.command ~= "goto" or #target_step.args < 1 then
+            return target
+        end
+
+        if visited[target] then
+            error("goto loop without any steps in between in cutscene " .. cutscene_name)
+        end
+
+        visited[target] = true
+        label = target_step.args[1]
+        target = label_locations[label]
+    end
+end
+
+local function is_goto_step(step)
+    return step.type.value == 'CutsceneStepTypeGoto'
+end
+
+-- replays the jumps the way cutsceneRunnerStartStep does to make sure
+-- each goto lands in the cutscene, or right at its end, and never on
+-- another goto since the runtime only jumps once
+local function check_resolved_gotos(cutscene_name, steps)
+    for step_index, step in ipairs(steps) do
+        if is_goto_step(step) then
+            local target = step.gotoStep[1]
+
+            if target < 0 or target > #steps then
+                error("goto at step " .. (step_index - 1) .. " in cutscene " .. cutscene_name .. " resolved to step " .. target .. " which is outside of the cutscene")
+            end
+
+            if target < #steps and is_goto_step(steps[target + 1]) then
+                error("goto at step " .. (step_index - 1) .. " in cutscene " .. cutscene_name .. " resolved to step " .. target .. " which is another goto")
+            end
+        end
+    end
+end
+
 local function string_starts_with(str, prefix)
     return string.sub(str, 1, #prefix) == prefix
 end
 
-local function generate_cutscene_step(cutscene_name, step, step_index, label_locations, cutscenes)
+local function generate_cutscene_step(cutscene_name, steps, step, label_locations, cutscenes)
     local result = {}
 
     if step.command == "play_sound" or step.command == "start_sound" and #step.args >= 1 then
@@ -154,15 +203,8 @@ local function generate_cutscene_step(cutscene_name, step, step_index, label_loc
         }
     elseif step.command == "goto" and #step.args >= 1 then
         result.type = sk_definition_writer.raw('CutsceneStepTypeGoto')
-
-        local label_location = label_locations[step.args[1]]
-
-        if not label_location then
-            error("Unrecognized label '" .. step.args[1] .. "' in cutscene " .. cutscene_name)
-        end
-
         result.gotoStep = {
-            label_location - step_index,
+            resolve_goto_target(cutscene_name, steps, label_locations, step.args[1]) - 1,
         }
     elseif step.command == "start_cutscene" and #step.args >= 1 then
         result.type = sk_definition_writer.raw('CutsceneStepTypeStartCutscene')
@@ -284,10 +326,12 @@ local function generate_cutscenes()
 
         local steps = {}
 
-        for step_index, step in pairs(other_steps) do
-            table.insert(steps, generate_cutscene_step(cutscene.name, step, step_index, label_locations, cutscenes))
+        for _, step in ipairs(other_steps) do
+            table.insert(steps, generate_cutscene_step(cutscene.name, other_steps, step, label_locations, cutscenes))
         end
 
+        check_resolved_gotos(cutscene.name, steps)
+
         sk_definition_writer.add_definition(cutscene.name .. '_steps', 'struct CutsceneStep[]', '_geo', steps)
 
         table.insert(cutscenes_result, {
@@ -297,8 +341,8 @@ local function generate_cutscenes()
         })
 
         table.insert(cutscene_data, {
-            sk_definition_writer.reference_to(steps, 1),
-            #steps,
+            steps = sk_definition_writer.reference_to(steps, 1),
+            stepCount = #steps,
         })
     end
 
@@ -348,9 +392,9 @@ local function generate_triggers(cutscenes)
             local transformed = first_mesh:transform(trigger.node.full_transformation)
     
             table.insert(result, {
-                transformed.bb,
-                sk_definition_writer.reference_to(triggers, 1),
-                #triggers,
+                box = transformed.bb,
+                triggers = sk_definition_writer.reference_to(triggers, 1),
+                triggerCount = #triggers,
             })
 
             sk_definition_writer.add_definition("trigger_targets", "struct ObjectTriggerInfo[]", "_geo", triggers)
@@ -0,0 +1,433 @@
+// Host build of the portal surface generator that pokes portal loops into
+// randomly generated surfaces. Every byte of the input picks part of the
+// surface or the loop so it works both as a libFuzzer target and with the
+// plain random driver at the bottom of this file
+//
+// the game sources are built with malloc and free renamed so they
+// end up in portalFuzzMalloc and portalFuzzFree instead of libc
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "scene/portal_surface_generator.h"
+#include "scene/portal.h"
+#include "physics/collision_scene.h"
+#include "math/mathf.h"
+
+#if defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define PORTAL_FUZZ_ASAN
+#endif
+#endif
+
+#if defined(__SANITIZE_ADDRESS__) && !defined(PORTAL_FUZZ_ASAN)
+#define PORTAL_FUZZ_ASAN
+#endif
+
+#ifdef PORTAL_FUZZ_ASAN
+#include <sanitizer/asan_interface.h>
+#else
+#define ASAN_POISON_MEMORY_REGION(addr, size)   ((void)(addr), (void)(size))
+#define ASAN_UNPOISON_MEMORY_REGION(addr, size) ((void)(addr), (void)(size))
+#endif
+
+// keep these in sync with src/util/memory.c
+#define STACK_MALLOC_SIZE_BYTES    (8 * 1024)
+#define STACK_MALLOC_SIZE_WORDS (STACK_MALLOC_SIZE_BYTES >> 3)
+
+#define MAX_GRID_SIZE       6
+#define MAX_GRID_CELLS      21
+#define MIN_CELL_SIZE       64
+#define MAX_CELL_SIZE       1024
+#define MAX_SURFACE_SIZE    16000
+
+#define PORTAL_WIDTH_RADIUS     ((int)(PORTAL_COVER_WIDTH_RADIUS * FIXED_POINT_SCALAR))
+#define PORTAL_HEIGHT_RADIUS    ((int)(PORTAL_COVER_HEIGHT_RADIUS * FIXED_POINT_SCALAR))
+#define PORTAL_PADDING          8
+
+#define MIN_FUZZ_SCALE  0.1f
+
+#define POKES_PER_INPUT 8
+
+#define DEFAULT_ITERATIONS  100000
+
+///////////////////////////////////
+// memory.h replacement
+
+int gStackMallocAt;
+long long gStackMalloc[STACK_MALLOC_SIZE_WORDS];
+
+void* portalFuzzMalloc(unsigned int size) {
+    return malloc(size);
+}
+
+void portalFuzzFree(void* target) {
+    free(target);
+}
+
+void zeroMemory(void* memory, int size) {
+    memset(memory, 0, size);
+}
+
+void memCopy(void* target, const void* src, int size) {
+    memcpy(target, src, size);
+}
+
+void stackMallocReset() {
+    gStackMallocAt = 0;
+    ASAN_POISON_MEMORY_REGION(gStackMalloc, sizeof(gStackMalloc));
+}
+
+void stackMallocFree(void* ptr) {
+    void* currentHead = &gStackMalloc[gStackMallocAt];
+
+    if (ptr < currentHead) {
+        gStackMallocAt = (long long*)ptr - gStackMalloc;
+        ASAN_POISON_MEMORY_REGION(ptr, (char*)currentHead - (char*)ptr);
+    }
+}
+
+// same as the game except running out of space is an error
+// and anything past the top of the stack is poisoned
+void* stackMalloc(int size) {
+    int nWords = (size + 7) >> 3;
+
+    if (gStackMallocAt + nWords > STACK_MALLOC_SIZE_WORDS) {
+        fprintf(stderr, "stackMalloc out of space requesting %d bytes with %d used\n", size, gStackMallocAt * 8);
+        abort();
+    }
+
+    void* result = &gStackMalloc[gStackMallocAt];
+    gStackMallocAt += nWords;
+    ASAN_UNPOISON_MEMORY_REGION(result, size);
+    return result;
+}
+
+///////////////////////////////////
+// input
+
+struct FuzzInput {
+    const unsigned char* data;
+    size_t size;
+    size_t at;
+};
+
+static int fuzzInputByte(struct FuzzInput* input) {
+    if (input->at >= input->size) {
+        return 0;
+    }
+
+    return input->data[input->at++];
+}
+
+static int fuzzInputShort(struct FuzzInput* input) {
+    int result = fuzzInputByte(input);
+    return result | (fuzzInputByte(input) << 8);
+}
+
+// min and max are inclusive
+static int fuzzInputRange(struct FuzzInput* input, int min, int max) {
+    if (max <= min) {
+        return min;
+    }
+
+    return min + fuzzInputShort(input) % (max - min + 1);
+}
+
+///////////////////////////////////
+// surface
+
+struct FuzzSurface {
+    struct Vector2s16 vertices[(MAX_GRID_SIZE + 1) * (MAX_GRID_SIZE + 1)];
+    struct SurfaceEdge edges[MAX_GRID_CELLS * 6];
+    Vtx gfxVertices[(MAX_GRID_SIZE + 1) * (MAX_GRID_SIZE + 1)];
+    short edgeForPoints[(MAX_GRID_SIZE + 1) * (MAX_GRID_SIZE + 1)][(MAX_GRID_SIZE + 1) * (MAX_GRID_SIZE + 1)];
+
+    struct PortalSurface surface;
+    int width;
+    int height;
+};
+
+// mirrors calculate_portal_single_surface in tools/level_scripts/portal_surfaces.lua
+static void fuzzSurfaceAddTriangle(struct FuzzSurface* fuzzSurface, int a, int b, int c) {
+    int face[3] = {a, b, c};
+    int firstEdge = fuzzSurface->surface.edgeCount;
+
+    for (int i = 0; i < 3; ++i) {
+        int edgeIndex = firstEdge + i;
+        struct SurfaceEdge* edge = &fuzzSurface->edges[edgeIndex];
+
+        int current = face[i];
+        int next = face[(i + 1) % 3];
+
+        edge->pointIndex = current;
+        edge->nextEdge = firstEdge + (i + 1) % 3;
+        edge->prevEdge = firstEdge + (i + 2) % 3;
+        edge->reverseEdge = NO_EDGE_CONNECTION;
+
+        short* existing = &fuzzSurface->edgeForPoints[MIN(current, next)][MAX(current, next)];
+
+        if (*existing != -1) {
+            edge->reverseEdge = *existing;
+            fuzzSurface->edges[*existing].reverseEdge = edgeIndex;
+            *existing = -1;
+        } else {
+            *existing = edgeIndex;
+        }
+    }
+
+    fuzzSurface->surface.edgeCount += 3;
+}
+
+static void fuzzSurfaceGenerate(struct FuzzSurface* fuzzSurface, struct FuzzInput* input) {
+    memset(fuzzSurface, 0, sizeof(struct FuzzSurface));
+    memset(fuzzSurface->edgeForPoints, 0xFF, sizeof(fuzzSurface->edgeForPoints));
+
+    int columns = fuzzInputRange(input, 1, MAX_GRID_SIZE);
+    int rows = fuzzInputRange(input, 1, MIN(MAX_GRID_SIZE, MAX_GRID_CELLS / columns));
+
+    // the surface has to be big enough to fit a portal at any angle
+    int minSize = (PORTAL_HEIGHT_RADIUS + PORTAL_PADDING) * 2;
+
+    int cellWidth = fuzzInputRange(input, MAX(MIN_CELL_SIZE, minSize / columns + 1), MIN(MAX_CELL_SIZE, MAX_SURFACE_SIZE / columns));
+    int cellHeight = fuzzInputRange(input, MAX(MIN_CELL_SIZE, minSize / rows + 1), MIN(MAX_CELL_SIZE, MAX_SURFACE_SIZE / rows));
+
+    fuzzSurface->width = cellWidth * columns;
+    fuzzSurface->height = cellHeight * rows;
+
+    int originX = -fuzzSurface->width / 2;
+    int originY = -fuzzSurface->height / 2;
+
+    for (int y = 0; y <= rows; ++y) {
+        for (int x = 0; x <= columns; ++x) {
+            int index = y * (columns + 1) + x;
+            struct Vector2s16* vertex = &fuzzSurface->vertices[index];
+
+            vertex->x = originX + x * cellWidth;
+            vertex->y = originY + y * cellHeight;
+
+            // the outline stays a rectangle but the inside gets nudged around
+            if (x > 0 && x < columns) {
+                vertex->x += fuzzInputRange(input, -cellWidth / 8, cellWidth / 8);
+            }
+
+            if (y > 0 && y < rows) {
+                vertex->y += fuzzInputRange(input, -cellHeight / 8, cellHeight / 8);
+            }
+
+            Vtx_t* gfxVertex = &fuzzSurface->gfxVertices[index].v;
+            gfxVertex->ob[0] = vertex->x >> 2;
+            gfxVertex->ob[1] = vertex->y >> 2;
+            gfxVertex->ob[2] = 0;
+            gfxVertex->tc[0] = vertex->x;
+            gfxVertex->tc[1] = vertex->y;
+            gfxVertex->cn[0] = x * 255 / columns;
+            gfxVertex->cn[1] = y * 255 / rows;
+            gfxVertex->cn[2] = 128;
+            gfxVertex->cn[3] = 255;
+        }
+    }
+
+    for (int y = 0; y < rows; ++y) {
+        for (int x = 0; x < columns; ++x) {
+            int bottomLeft = y * (columns + 1) + x;
+            int bottomRight = bottomLeft + 1;
+            int topLeft = bottomLeft + columns + 1;
+            int topRight = topLeft + 1;
+
+            if (fuzzInputByte(input) & 0x1) {
+                fuzzSurfaceAddTriangle(fuzzSurface, bottomLeft, bottomRight, topRight);
+                fuzzSurfaceAddTriangle(fuzzSurface, bottomLeft, topRight, topLeft);
+            } else {
+                fuzzSurfaceAddTriangle(fuzzSurface, bottomLeft, bottomRight, topLeft);
+                fuzzSurfaceAddTriangle(fuzzSurface, bottomRight, topRight, topLeft);
+            }
+        }
+    }
+
+    fuzzSurface->surface.vertices = fuzzSurface->vertices;
+    fuzzSurface->surface.edges = fuzzSurface->edges;
+    fuzzSurface->surface.vertexCount = (columns + 1) * (rows + 1);
+    fuzzSurface->surface.right = gRight;
+    fuzzSurface->surface.up = gUp;
+    fuzzSurface->surface.corner = gZeroVec;
+    fuzzSurface->surface.gfxVertices = fuzzSurface->gfxVertices;
+    fuzzSurface->surface.triangles = NULL;
+}
+
+///////////////////////////////////
+// portal loop
+
+// same shape as gPortalOutline, scaled and rotated the way an
+// opening portal on a floor can be
+static void fuzzPortalLoop(struct FuzzSurface* fuzzSurface, struct FuzzInput* input, struct Vector2s16* loop) {
+    static const float outline[PORTAL_LOOP_SIZE][2] = {
+        {0.0f, 1.0f},
+        {0.707107f, 0.707107f},
+        {1.0f, 0.0f},
+        {0.707107f, -0.707107f},
+        {0.0f, -1.0f},
+        {-0.707107f, -0.707107f},
+        {-1.0f, 0.0f},
+        {-0.707107f, 0.707107f},
+    };
+
+    float scale = MIN_FUZZ_SCALE + (1.0f - MIN_FUZZ_SCALE) * fuzzInputByte(input) * (1.0f / 255.0f);
+    float angle = fuzzInputShort(input) * (2.0f * 3.14159265f / 65536.0f);
+    float cosAngle = cosf(angle);
+    float sinAngle = sinf(angle);
+
+    // portalSurfaceAdjustPosition keeps a portal this far from the edge
+    int radius = PORTAL_HEIGHT_RADIUS + PORTAL_PADDING;
+    int rangeX = fuzzSurface->width / 2 - radius;
+    int rangeY = fuzzSurface->height / 2 - radius;
+
+    int centerX = fuzzInputRange(input, -rangeX, rangeX);
+    int centerY = fuzzInputRange(input, -rangeY, rangeY);
+
+    for (int i = 0; i < PORTAL_LOOP_SIZE; ++i) {
+        float x = outline[i][0] * PORTAL_WIDTH_RADIUS * scale;
+        float y = outline[i][1] * PORTAL_HEIGHT_RADIUS * scale;
+
+        loop[i].x = centerX + (short)floorf(x * cosAngle - y * sinAngle + 0.5f);
+        loop[i].y = centerY + (short)floorf(x * sinAngle + y * cosAngle + 0.5f);
+    }
+}
+
+///////////////////////////////////
+// checks
+
+struct FuzzResults {
+    int pokes;
+    int failed;
+};
+
+struct FuzzResults gFuzzResults;
+
+static void fuzzFail(char* reason, struct PortalSurface* surface, struct Vector2s16* loop) {
+    fprintf(stderr, "%s\n", reason);
+    fprintf(stderr, "surface vertices %d edges %d\n", surface->vertexCount, surface->edgeCount);
+
+    for (int i = 0; i < PORTAL_LOOP_SIZE; ++i) {
+        fprintf(stderr, "loop[%d] = %d %d\n", i, loop[i].x, loop[i].y);
+    }
+
+    abort();
+}
+
+// checks what portalSurfaceIsWellFormed can't see from inside the builder
+static void fuzzCheckResult(struct PortalSurface* original, struct PortalSurface* result, struct Vector2s16* loop) {
+    if (result->vertexCount < original->vertexCount || result->edgeCount < original->edgeCount) {
+        fuzzFail("result lost vertices or edges", original, loop);
+    }
+
+    if (memcmp(result->vertices, original->vertices, sizeof(struct Vector2s16) * original->vertexCount) != 0) {
+        fuzzFail("result moved an original vertex", original, loop);
+    }
+
+    for (int i = 0; i < result->edgeCount; ++i) {
+        struct SurfaceEdge* edge = &result->edges[i];
+
+        if (edge->nextEdge == NO_EDGE_CONNECTION) {
+            continue;
+        }
+
+        if (edge->pointIndex >= result->vertexCount || edge->nextEdge >= result->edgeCount || edge->prevEdge >= result->edgeCount) {
+            fuzzFail("result edge out of range", original, loop);
+        }
+    }
+}
+
+static void fuzzPoke(struct FuzzSurface* fuzzSurface, struct FuzzInput* input) {
+    struct Vector2s16 loop[PORTAL_LOOP_SIZE];
+    fuzzPortalLoop(fuzzSurface, input, loop);
+
+    int malformedBefore = gPortalSurfacePokeStats.failures[PortalSurfacePokeFailureMalformed];
+
+    struct PortalSurface result;
+    int success = portalSurfacePokeHole(&fuzzSurface->surface, loop, &result);
+
+    ++gFuzzResults.pokes;
+
+    if (gPortalSurfacePokeStats.failures[PortalSurfacePokeFailureMalformed] != malformedBefore) {
+        fuzzFail("portalSurfaceIsWellFormed rejected the result", &fuzzSurface->surface, loop);
+    }
+
+    if (gStackMallocAt != 0) {
+        fuzzFail("portalSurfacePokeHole leaked stackMalloc space", &fuzzSurface->surface, loop);
+    }
+
+    if (!success) {
+        ++gFuzzResults.failed;
+        return;
+    }
+
+    fuzzCheckResult(&fuzzSurface->surface, &result, loop);
+
+    portalFuzzFree(result.vertices);
+    portalFuzzFree(result.edges);
+    portalFuzzFree(result.gfxVertices);
+    portalFuzzFree(result.triangles);
+}
+
+int LLVMFuzzerTestOneInput(const unsigned char* data, size_t size) {
+    static struct FuzzSurface fuzzSurface;
+    struct FuzzInput input = {data, size, 0};
+
+    stackMallocReset();
+    fuzzSurfaceGenerate(&fuzzSurface, &input);
+
+    for (int i = 0; i < POKES_PER_INPUT; ++i) {
+        fuzzPoke(&fuzzSurface, &input);
+    }
+
+    return 0;
+}
+
+///////////////////////////////////
+// random driver
+
+#ifndef PORTAL_SURFACE_LIBFUZZER
+
+static void fuzzReport() {
+    printf("pokes %d failed %d\n", gFuzzResults.pokes, gFuzzResults.failed);
+
+    for (int i = 0; i < PortalSurfacePokeFailureCount; ++i) {
+        printf("failure %d count %d\n", i, gPortalSurfacePokeStats.failures[i]);
+    }
+
+    printf("edges +%d vertices +%d stack %d\n",
+        gPortalSurfacePokeStats.maxAddedEdges,
+        gPortalSurfacePokeStats.maxAddedVertices,
+        gPortalSurfacePokeStats.maxStackUsage
+    );
+    printf("capacity exceeded edges %d vertices %d\n",
+        gPortalSurfacePokeStats.edgeCapacityExceeded,
+        gPortalSurfacePokeStats.vertexCapacityExceeded
+    );
+}
+
+// usage: portal_surface_fuzz [iterations] [seed]
+int main(int argc, char** argv) {
+    int iterations = argc > 1 ? atoi(argv[1]) : DEFAULT_ITERATIONS;
+    unsigned seed = argc > 2 ? (unsigned)strtoul(argv[2], NULL, 0) : 1;
+
+    unsigned char data[256];
+
+    srand(seed);
+
+    for (int iteration = 0; iteration < iterations; ++iteration) {
+        for (int i = 0; i < (int)sizeof(data); ++i) {
+            data[i] = rand() & 0xFF;
+        }
+
+        LLVMFuzzerTestOneInput(data, sizeof(data));
+    }
+
+    fuzzReport();
+
+    return 0;
+}
+
+#endif